@@ -41,17 +41,69 @@ static int compute_addr(const instr_t *ip, ca_temp_t *ca_tempp);
 static int addr_append(t_uint64 *wordp);
 static int do_its_itp(const instr_t* ip, ca_temp_t *ca_tempp, t_uint64 word01);
 static int page_in(uint offset, uint perm_mode, uint *addrp, uint *minaddrp, uint *maxaddrp);
+static int page_in_span(uint offset, uint *addrp, uint *nwordsp);
+static uint page_in_bound;  // segment bound seen by the last successful page_in()
 static void decode_PTW(t_uint64 word, PTW_t *ptwp);
 static int set_PTW_used(uint addr);
 static void decode_SDW(t_uint64 word0, t_uint64 word1, SDW_t *sdwp);
 // static SDW_t* get_sdw(void);
 static SDWAM_t* page_in_sdw(void);
-static int page_in_page(SDWAM_t* SDWp, uint offset, uint perm_mode, uint *addrp, uint *minaddrp, uint *maxaddrp);
+static int page_in_page(SDWAM_t* SDWp, uint offset, uint perm_mode, uint *addrp, uint *minaddrp, uint *maxaddrp, PTWAM_t **PTWpp);
+static void sdwam_touch(SDWAM_t *SDWp);
+static void ptwam_touch(PTWAM_t *PTWp);
 static void register_mod(uint td, uint off, uint *bitnop, int nbits);
 static void dump_descriptor_table(void);
 
 //=============================================================================
 
+#if FEAT_APU_TLB
+// Translation cache in front of the SDWAM and PTWAM.  Direct mapped on
+// (segno, page).  An entry is only ever filled from SDWAM/PTWAM entries
+// that page_in() has just used successfully, and the cache is flushed
+// whenever an associative memory entry is loaded, replaced, or cleared, so
+// a hit always agrees with what the associative memories would return.
+// No ring is part of the key because page_in() does no access checks.
+
+typedef struct {
+    uint gen;           // valid only if equal to tlb_gen
+    uint segno;
+    uint pageno;        // offset / page_size
+    uint bound;         // first offset past the end of the segment
+    uint base;          // absolute address of the first word of the page
+    uint minaddr;       // as returned by page_in()
+    uint maxaddr;
+    SDWAM_t *SDWp;
+    PTWAM_t *PTWp;      // NULL for unpaged segments
+} tlb_t;
+
+static tlb_t tlb[1 << 8];
+static uint tlb_gen = 1;
+
+#define TLB_INDEX(segno, pageno) \
+    ((((segno) << 2) ^ (pageno)) & (ARRAY_SIZE(tlb) - 1))
+#endif
+
+//=============================================================================
+
+/*
+ * apu_tlb_flush()
+ *
+ * Discard all translations cached by page_in().  Called whenever the DSBR,
+ * SDWAM, or PTWAM change.
+ */
+
+void apu_tlb_flush(void)
+{
+#if FEAT_APU_TLB
+    if (++tlb_gen == 0) {
+        memset(tlb, 0, sizeof(tlb));
+        tlb_gen = 1;
+    }
+#endif
+}
+
+//=============================================================================
+
 static inline uint max3(uint a, uint b, uint c)
 {
     return (a > b) ?
@@ -816,7 +868,7 @@ static int compute_addr(const instr_t *ip, ca_temp_t *ca_tempp)
             if (cu.rpt || cu.rd) {
                 int n = td & 07;
                 reg_X[n] = TPR.CA;
-                if (opt_debug>0 || cu.rd) {
+                if (opt_debug>0) {
                     log_msg((cu.rpt) ? DEBUG_MSG : INFO_MSG, "APU",
                         "RI for repeated instr: Setting X[%d] to CA 0%o(%d).\n",
                         n, reg_X[n], reg_X[n]);
@@ -1371,8 +1423,9 @@ int fetch_appended(uint offset, t_uint64 *wordp)
         return fetch_abs_word(offset, wordp);
     }
 
-    t_uint64 simh_addr = addr_emul_to_simh(addr_mode, TPR.TSR, offset);
-    if (sim_brk_summ) {
+    int brk = sim_brk_summ && brk_page_flagged(addr_mode, TPR.TSR, offset);
+    t_uint64 simh_addr = brk ? addr_emul_to_simh(addr_mode, TPR.TSR, offset) : 0;
+    if (brk) {
         if (sim_brk_test(simh_addr, SWMASK('M'))) {
             log_msg(WARN_MSG, "APU", "Memory Breakpoint on read.\n");
             cancel_run(STOP_IBKPT);
@@ -1386,7 +1439,7 @@ int fetch_appended(uint offset, t_uint64 *wordp)
         if(opt_debug>0) log_msg(DEBUG_MSG, "APU::fetch_append", "Using addr 0%o\n", addr);
         ret = fetch_abs_word(addr, wordp);
         if (ret == 0) {
-            if (cpu.cycle != FETCH_cycle && sim_brk_test (simh_addr, SWMASK ('D'))) {
+            if (brk && cpu.cycle != FETCH_cycle && sim_brk_test (simh_addr, SWMASK ('D'))) {
                 extern UNIT cpu_unit;   // FIXME
                 out_sym(0, simh_addr, wordp, &cpu_unit, SWMASK('M') | SWMASK('A'));
             }
@@ -1409,8 +1462,9 @@ int store_appended(uint offset, t_uint64 word)
         cancel_run(STOP_BUG);
     }
 
-    t_uint64 simh_addr = addr_emul_to_simh(addr_mode, TPR.TSR, offset);
-    if (sim_brk_summ) {
+    int brk = sim_brk_summ && brk_page_flagged(addr_mode, TPR.TSR, offset);
+    t_uint64 simh_addr = brk ? addr_emul_to_simh(addr_mode, TPR.TSR, offset) : 0;
+    if (brk) {
         if (sim_brk_test(simh_addr, SWMASK('W') | SWMASK('M'))) {
             log_msg(WARN_MSG, "APU", "Memory Breakpoint on write.\n");
             cancel_run(STOP_IBKPT);
@@ -1424,7 +1478,7 @@ int store_appended(uint offset, t_uint64 word)
         if(opt_debug>0) log_msg(DEBUG_MSG, "APU::store-append", "Using addr 0%o\n", addr);
         ret = store_abs_word(addr, word);
         if (ret == 0)
-            if (sim_brk_test (simh_addr, SWMASK ('D'))) {
+            if (brk && sim_brk_test (simh_addr, SWMASK ('D'))) {
                 extern UNIT cpu_unit;   // FIXME
                 out_sym(1, simh_addr, &word, &cpu_unit, SWMASK('M') | SWMASK('A'));
             }
@@ -1435,6 +1489,81 @@ int store_appended(uint offset, t_uint64 word)
 
 //=============================================================================
 
+/*
+ * fetch_appended_block()
+ * store_appended_block()
+ *
+ * Move n words between a buffer and consecutive offsets of the current
+ * segment.  Translation is done once per page rather than once per word,
+ * and the words are moved directly to or from Mem[] when mem_direct_ok()
+ * allows.  Words on pages that might hold breakpoints, and all words when
+ * debugging, go through fetch_appended() or store_appended() instead.
+ */
+
+int fetch_appended_block(uint offset, uint n, t_uint64 *wordsp)
+{
+    addr_modes_t addr_mode = get_addr_mode();
+    while (n > 0) {
+        int ret;
+        uint k;
+        if (addr_mode != APPEND_mode || opt_debug || (sim_brk_summ && brk_page_flagged(addr_mode, TPR.TSR, offset))) {
+            ret = fetch_appended(offset, wordsp);
+            k = 1;
+        } else {
+            uint addr;
+            if ((ret = page_in_span(offset, &addr, &k)) != 0)
+                return ret;
+            if (k > n)
+                k = n;
+            if (mem_direct_ok(addr, addr + k - 1)) {
+                memcpy(wordsp, &Mem[addr], k * sizeof(*wordsp));
+                cpu.read_addr = addr + k - 1;
+            } else
+                for (uint i = 0; ret == 0 && i < k; ++i)
+                    ret = fetch_abs_word(addr + i, wordsp + i);
+        }
+        if (ret != 0)
+            return ret;
+        offset += k;
+        wordsp += k;
+        n -= k;
+    }
+    return 0;
+}
+
+int store_appended_block(uint offset, uint n, const t_uint64 *wordsp)
+{
+    addr_modes_t addr_mode = get_addr_mode();
+    while (n > 0) {
+        int ret;
+        uint k;
+        if (addr_mode != APPEND_mode || opt_debug || (sim_brk_summ && brk_page_flagged(addr_mode, TPR.TSR, offset))) {
+            ret = store_appended(offset, *wordsp);
+            k = 1;
+        } else {
+            uint addr;
+            if ((ret = page_in_span(offset, &addr, &k)) != 0)
+                return ret;
+            if (k > n)
+                k = n;
+            if (mem_direct_ok(addr, addr + k - 1)) {
+                memcpy(&Mem[addr], wordsp, k * sizeof(*wordsp));
+                mem_stored(addr, addr + k - 1);
+            } else
+                for (uint i = 0; ret == 0 && i < k; ++i)
+                    ret = store_abs_word(addr + i, wordsp[i]);
+        }
+        if (ret != 0)
+            return ret;
+        offset += k;
+        wordsp += k;
+        n -= k;
+    }
+    return 0;
+}
+
+//=============================================================================
+
 int cmd_dump_vm(int32 arg, char *buf)
 {
     // Dump VM info -- display the cache registers & descriptor table
@@ -1625,6 +1754,22 @@ static int page_in(uint offset, uint perm_mode, uint *addrp, uint *minaddrp, uin
     uint segno = TPR.TSR;   // Should be been loaded with PPR.PSR if this is an instr fetch...
     // if(opt_debug>0) log_msg(DEBUG_MSG, moi, "Starting for Segno=0%o, offset=0%o.  (PPR.PSR is 0%o)\n", segno, offset, PPR.PSR);
 
+#if FEAT_APU_TLB
+    uint pageno = offset / page_size;
+    tlb_t *tp = &tlb[TLB_INDEX(segno, pageno)];
+    if (tp->gen == tlb_gen && tp->segno == segno && tp->pageno == pageno && offset < tp->bound && perm_mode == 0 && ! opt_debug) {
+        // Keep the LRU order of the associative memories as if they had been searched
+        sdwam_touch(tp->SDWp);
+        if (tp->PTWp != NULL)
+            ptwam_touch(tp->PTWp);
+        *addrp = tp->base + offset % page_size;
+        *minaddrp = tp->minaddr;
+        *maxaddrp = tp->maxaddr;
+        page_in_bound = tp->bound;
+        return 0;
+    }
+#endif
+
     // ERROR: Validate that all PTWAM & SDWAM entries are always "full" and that use fields are always sane
     SDWAM_t* SDWp = page_in_sdw();
     if (SDWp == NULL) {
@@ -1636,14 +1781,53 @@ static int page_in(uint offset, uint perm_mode, uint *addrp, uint *minaddrp, uin
         log_msg(WARN_MSG, moi, "SDW not loaded\n");
         return 1;
     }
-    int ret = page_in_page(SDWp, offset, perm_mode, addrp, minaddrp, maxaddrp);
+    PTWAM_t *PTWp;
+    int ret = page_in_page(SDWp, offset, perm_mode, addrp, minaddrp, maxaddrp, &PTWp);
     if (ret != 0) {
         log_msg(NOTIFY_MSG, moi, "page_in_page returned non zero.  Segno %#o, offset %#o(%d)\n", segno, offset, offset);
+        return ret;
     }
-    return ret;
+    page_in_bound = 16 * (SDWp->sdw.bound + 1);
+#if FEAT_APU_TLB
+    if (SDWp->assoc.ptr == segno && SDWp->assoc.is_full) {
+        tp->gen = tlb_gen;
+        tp->segno = segno;
+        tp->pageno = pageno;
+        tp->bound = 16 * (SDWp->sdw.bound + 1);
+        tp->base = *addrp - offset % page_size;
+        tp->minaddr = *minaddrp;
+        tp->maxaddr = *maxaddrp;
+        tp->SDWp = SDWp;
+        tp->PTWp = PTWp;
+    }
+#endif
+    return 0;
 }
 
 
+//=============================================================================
+
+/*
+ * page_in_span()
+ *
+ * Like page_in(), but returns the number of words starting at the given
+ * offset that lie within both the page and the segment bound instead of
+ * the page limits.
+ */
+
+static int page_in_span(uint offset, uint *addrp, uint *nwordsp)
+{
+    uint minaddr, maxaddr;
+    int ret = page_in(offset, 0, addrp, &minaddr, &maxaddr);
+    if (ret != 0)
+        return ret;
+    uint n = maxaddr - *addrp + 1;
+    if (n > page_in_bound - offset)
+        n = page_in_bound - offset;     // paged segments may end mid-page
+    *nwordsp = n;
+    return 0;
+}
+
 //=============================================================================
 
 /*
@@ -1792,13 +1976,7 @@ static SDWAM_t* page_in_sdw()
     if (SDWp != NULL) {
         // SDW is in SDWAM; it moves to the end of the LRU queue
         // log_msg(DEBUG_MSG, moi, "SDW is in SDWAM[%d].\n", SDWp - cpup->SDWAM);
-        if (SDWp->assoc.use != 15) {
-            for (int i = 0; i < ARRAY_SIZE(cpup->SDWAM); ++i) {
-                if (cpup->SDWAM[i].assoc.use > SDWp->assoc.use)
-                    -- cpup->SDWAM[i].assoc.use;
-            }
-            SDWp->assoc.use = 15;
-        }
+        sdwam_touch(SDWp);
         return SDWp;
     }
 
@@ -1875,6 +2053,7 @@ static SDWAM_t* page_in_sdw()
     for (int i = 0; i < ARRAY_SIZE(cpup->SDWAM); ++i) {
         -- cpup->SDWAM[i].assoc.use;
     }
+    apu_tlb_flush();    // translations may refer to the entry being replaced
     SDWp = cpup->SDWAM + oldest_sdwam;
     decode_SDW(sdw_word0, sdw_word1, &SDWp->sdw);
     SDWp->assoc.ptr = segno;
@@ -1893,7 +2072,45 @@ static SDWAM_t* page_in_sdw()
 
 //=============================================================================
 
-static int page_in_page(SDWAM_t* SDWp, uint offset, uint perm_mode, uint *addrp, uint *minaddrp, uint *maxaddrp)
+/*
+ * sdwam_touch()
+ * ptwam_touch()
+ *
+ * Make the given associative memory entry the most recently used one.
+ */
+
+static void sdwam_touch(SDWAM_t *SDWp)
+{
+    if (SDWp->assoc.use != 15) {
+        for (int i = 0; i < ARRAY_SIZE(cpup->SDWAM); ++i) {
+            if (cpup->SDWAM[i].assoc.use > SDWp->assoc.use)
+                -- cpup->SDWAM[i].assoc.use;
+        }
+        SDWp->assoc.use = 15;
+    }
+}
+
+static void ptwam_touch(PTWAM_t *PTWp)
+{
+    if (PTWp->assoc.use != 15) {
+        for (int i = 0; i < ARRAY_SIZE(cpup->PTWAM); ++i) {
+            if (cpup->PTWAM[i].assoc.use > PTWp->assoc.use)
+                -- cpup->PTWAM[i].assoc.use;
+        }
+        PTWp->assoc.use = 15;
+    }
+}
+
+//=============================================================================
+
+/*
+ * page_in_page()
+ *
+ * Second half of page_in().  On success, *PTWpp is set to the PTWAM entry
+ * used, or to NULL for an unpaged segment.
+ */
+
+static int page_in_page(SDWAM_t* SDWp, uint offset, uint perm_mode, uint *addrp, uint *minaddrp, uint *maxaddrp, PTWAM_t **PTWpp)
 {
     // Second part of page_in()
     // 
@@ -1929,6 +2146,7 @@ static int page_in_page(SDWAM_t* SDWp, uint offset, uint perm_mode, uint *addrp,
         *addrp = SDWp->sdw.addr + offset;
         *minaddrp = SDWp->sdw.addr;
         *maxaddrp = SDWp->sdw.addr + bound - 1;
+        *PTWpp = NULL;
         // log_msg(DEBUG_MSG, "APU::append", "Resulting addr is 0%o (0%o+0%o)\n", *addrp,  SDWp->sdw.addr, offset);
     } else {
         // Segment is paged -- find appropriate page
@@ -1960,13 +2178,7 @@ static int page_in_page(SDWAM_t* SDWp, uint offset, uint perm_mode, uint *addrp,
         }
         if (PTWp != NULL) {
             // PTW is in PTWAM; it becomes the LRU
-            if (PTWp->assoc.use != 15) {
-                for (int i = 0; i < ARRAY_SIZE(cpup->PTWAM); ++i) {
-                    if (cpup->PTWAM[i].assoc.use > PTWp->assoc.use)
-                        -- cpup->PTWAM[i].assoc.use;
-                }
-                PTWp->assoc.use = 15;
-            }
+            ptwam_touch(PTWp);
         } else {
             // Fetch PTW and put into PTWAM -- PTW cycle
             if (oldest_ptwam == -1) {
@@ -1982,6 +2194,7 @@ static int page_in_page(SDWAM_t* SDWp, uint offset, uint perm_mode, uint *addrp,
             for (int i = 0; i < ARRAY_SIZE(cpup->PTWAM); ++i) {
                 -- cpup->PTWAM[i].assoc.use;
             }
+            apu_tlb_flush();    // translations may refer to the entry being replaced
             PTWp = cpup->PTWAM + oldest_ptwam;
             decode_PTW(word, &PTWp->ptw);
             PTWp->assoc.use = 15;
@@ -1997,6 +2210,7 @@ static int page_in_page(SDWAM_t* SDWp, uint offset, uint perm_mode, uint *addrp,
         *minaddrp = (PTWp->ptw.addr << 6);
         *addrp = *minaddrp + y2;
         *maxaddrp = *minaddrp + page_size - 1;
+        *PTWpp = PTWp;
         // log_msg(DEBUG_MSG, "APU::append", "Resulting addr is 0%o (0%o<<6+0%o)\n", *addrp,  PTWp->ptw.addr, y2);
     }
 
@@ -99,6 +99,20 @@ void check_seg_debug()
 
 //=============================================================================
 
+int seg_debug_any()
+{
+    // Returns true if any segment has debugging forced on via xdebug.
+
+    if (!seg_debug_init_done)
+        return 0;
+    for (unsigned i = 0; i < ARRAY_SIZE(seg_debug); ++i)
+        if (seg_debug[i] == 1)
+            return 1;
+    return 0;
+}
+
+//=============================================================================
+
 void state_save()
 {
     // Save CPU state so that state_dump_changes() can report on any interesting changes.
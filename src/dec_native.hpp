@@ -0,0 +1,214 @@
+/*
+   Copyright (c) 2007-2013 Michael Mondy
+
+   This software is made available under the terms of the
+   ICU License -- ICU 1.8.1 and later.     
+   See the LICENSE file at the top-level directory of this distribution and
+   at http://example.org/project/LICENSE.
+*/
+
+/*
+ * Decimal operands of the EIS decimal instructions, the decNumber context
+ * they use, and the native arithmetic for short operands.  Shared by
+ * eis_opu.cpp and dectst.cpp, which checks the native arithmetic against
+ * decNumber.
+ */
+
+#ifndef _DEC_NATIVE_HPP
+#define _DEC_NATIVE_HPP
+
+extern "C" {
+#include <decNumber.h>
+}
+
+static void multics_decContext(decContext& context, flag_t scaled)
+{
+    decContextDefault(&context, DEC_INIT_BASE);
+    context.digits = 63;
+    int exp_digits = scaled ? 6 : 8;
+    context.emax = (2 << (exp_digits - 1)) - 1;
+    context.emin = - (2 << (exp_digits -1));
+    context.round = DEC_ROUND_HALF_UP;
+    context.clamp = 0;
+}
+
+// ----------------------------------------------------------------------------
+
+class dec_t {
+public:
+    // t_uint64 coe_val;
+    unsigned coe[65];       // original raw data, 0..9 or '0' .. '9'
+    // flag_t is_ascii;     // true if all the above are '0' .. '9'
+    char coe_text[65];      // '0' .. '9'
+    int width;              // width in bits of raw source data
+    int n_lz;               // number of leading zeros
+    int n_coe;
+    unsigned sign_nibble;   // original raw 4-bit or 9-bit sign byte
+    flag_t is_neg;          // sign byte intrepreted
+    flag_t is_zero; 
+    int exp;    // From floating point exponent or fixed point scale
+    dec_t() {}
+    dec_t(decNumber& decnum);
+};
+
+// ============================================================================
+
+#if FEAT_DEC_NATIVE
+
+/*
+ * Native decimal arithmetic
+ *
+ * Operands with few enough significant digits are held as 128-bit binary
+ * coefficients instead of being converted to decNumber via strings and
+ * heap allocations.  Results are built digit by digit into a dec_t and
+ * match what decNumber produces under multics_decContext(); callers fall
+ * back to decNumber for anything longer or out of exponent range.
+ */
+
+__extension__ typedef unsigned __int128 uint128;
+
+// Returns true if the coefficient of dec has at most maxdigits significant
+// digits (and so fits in a uint128 with room for scaling)
+static inline int dec_native_ok(const dec_t& dec, int maxdigits)
+{
+    return dec.n_coe - dec.n_lz <= maxdigits;
+}
+
+static uint128 dec_coe_value(const dec_t& dec)
+{
+    uint128 v = 0;
+    for (int i = dec.n_lz; i < dec.n_coe; ++i)
+        v = v * 10 + (dec.coe[i] & 0xf);
+    return v;
+}
+
+/*
+ * dec_compare_native()
+ *
+ * Signed comparison of two decimal values; returns -1, 0, or 1 as per
+ * decNumberCompare().   Both values must pass dec_native_ok(dec, 38).
+ */
+
+static int dec_compare_native(const dec_t& a, const dec_t& b)
+{
+    int sa = a.is_zero ? 0 : a.is_neg ? -1 : 1;
+    int sb = b.is_zero ? 0 : b.is_neg ? -1 : 1;
+    if (sa != sb)
+        return (sa > sb) ? 1 : -1;
+    if (sa == 0)
+        return 0;
+
+    // Same sign; compare magnitudes via adjusted exponents and then
+    // via the coefficients scaled to the same number of digits
+    int na = a.n_coe - a.n_lz;
+    int nb = b.n_coe - b.n_lz;
+    int adj_a = a.exp + na - 1;
+    int adj_b = b.exp + nb - 1;
+    int mag;
+    if (adj_a != adj_b)
+        mag = (adj_a > adj_b) ? 1 : -1;
+    else {
+        uint128 ca = dec_coe_value(a);
+        uint128 cb = dec_coe_value(b);
+        for (; na < nb; ++na)
+            ca *= 10;
+        for (; nb < na; ++nb)
+            cb *= 10;
+        mag = (ca == cb) ? 0 : (ca > cb) ? 1 : -1;
+    }
+    return sa * mag;
+}
+
+/*
+ * dec_divide_native()
+ *
+ * Long division of dividend by a non-zero divisor giving the same 63 digit,
+ * round-half-up result as decNumberDivide().  The divisor must pass
+ * dec_native_ok(dec, 37) so that remainders can be scaled by ten without
+ * overflow, and the dividend dec_native_ok(dec, 38).  Returns non-zero if
+ * the result would leave the exponent range of multics_decContext().
+ */
+
+static int dec_divide_native(const dec_t& dividend, const dec_t& divisor, dec_t& quot)
+{
+    const int ndigits = 63;
+    uint128 a = dec_coe_value(dividend);
+    uint128 b = dec_coe_value(divisor);
+    uint128 q = a / b;
+    uint128 r = a % b;
+
+    unsigned char d[ndigits + 1];
+    int nd = 0;
+    int exp = dividend.exp - divisor.exp;   // the "ideal" exponent
+
+    // Integer digits of the quotient, at most 38 of them
+    if (q != 0) {
+        unsigned char tmp[40];
+        int n = 0;
+        for (; q != 0; q /= 10)
+            tmp[n++] = q % 10;
+        while (n > 0)
+            d[nd++] = tmp[--n];
+    }
+    // Fraction digits until the division is exact or we have one digit
+    // past the precision for rounding
+    while (r != 0 && nd <= ndigits) {
+        r *= 10;
+        unsigned digit = r / b;
+        r %= b;
+        -- exp;
+        if (nd == 0 && digit == 0)
+            continue;       // leading zero of a fraction
+        d[nd++] = digit;
+    }
+    if (nd > ndigits) {
+        int up = d[ndigits] >= 5;
+        nd = ndigits;
+        ++ exp;
+        int p;
+        for (p = nd - 1; up && p >= 0; --p) {
+            if (d[p] == 9)
+                d[p] = 0;
+            else {
+                ++ d[p];
+                up = 0;
+            }
+        }
+        if (up) {
+            // 999...9 rounded up to 1000...0
+            d[0] = 1;
+            ++ exp;
+        }
+    }
+
+    if (nd == 0) {
+        // decNumber gives a zero with the ideal exponent and the sign of
+        // the operation
+        d[nd++] = 0;
+    } else if (exp + nd - 1 < -256 || exp + nd - 1 > 255)
+        return 1;   // would need decNumber's subnormal or overflow handling
+
+    quot.n_coe = nd;
+    quot.n_lz = 0;
+    quot.is_zero = 1;
+    for (int i = 0; i < nd; ++i) {
+        quot.coe[i] = d[i];
+        quot.coe_text[i] = d[i] | '0';
+        if (quot.is_zero) {
+            if (d[i] == 0)
+                ++ quot.n_lz;
+            else
+                quot.is_zero = 0;
+        }
+    }
+    quot.coe_text[nd] = 0;
+    quot.width = 4;
+    quot.is_neg = dividend.is_neg ^ divisor.is_neg;
+    quot.sign_nibble = (quot.is_neg) ? 015 : 014;
+    quot.exp = exp;
+    return 0;
+}
+
+#endif // FEAT_DEC_NATIVE
+
+#endif // _DEC_NATIVE_HPP
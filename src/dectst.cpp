@@ -0,0 +1,186 @@
+/*
+   Copyright (c) 2007-2013 Michael Mondy
+
+   This software is made available under the terms of the
+   ICU License -- ICU 1.8.1 and later.
+   See the LICENSE file at the top-level directory of this distribution and
+   at http://example.org/project/LICENSE.
+*/
+
+/*
+    dectst.cpp -- differential test of the native decimal arithmetic
+
+    Checks dec_divide_native() and dec_compare_native() from dec_native.hpp
+    against decNumberDivide() and decNumberCompare() under the context
+    DV3D uses.  Small operands are tried exhaustively, followed by random
+    operands up to the native digit limits.  Run via "make check-dec".
+
+    usage: dectst [ncases [seed]]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hw6180.h"
+#include "dec_native.hpp"
+
+#if ! FEAT_DEC_NATIVE
+#error FEAT_DEC_NATIVE is not set in options.h; nothing to test
+#endif
+
+static int nfail;
+static long nchecked, nskipped;
+
+// ----------------------------------------------------------------------------
+
+/*
+ * make_dec()
+ *
+ * Fill in a dec_t the way read_dec() does for 4-bit data, given the digits
+ * as text.  Leading zeros are kept.
+ */
+
+static void make_dec(dec_t& dec, const char *digits, int is_neg, int exp)
+{
+    memset(&dec, 0, sizeof(dec));
+    dec.n_coe = strlen(digits);
+    dec.is_zero = 1;
+    for (int i = 0; i < dec.n_coe; ++i) {
+        dec.coe[i] = digits[i] - '0';
+        dec.coe_text[i] = digits[i];
+        if (dec.is_zero) {
+            if (digits[i] == '0')
+                ++ dec.n_lz;
+            else
+                dec.is_zero = 0;
+        }
+    }
+    dec.coe_text[dec.n_coe] = 0;
+    dec.width = 4;
+    dec.is_neg = is_neg;
+    dec.sign_nibble = (is_neg) ? 015 : 014;
+    dec.exp = exp;
+}
+
+// Text form of a dec_t that decNumberFromString() accepts
+static char *dec_text(const dec_t& dec, char *buf)
+{
+    sprintf(buf, "%s%sE%d", dec.is_neg ? "-" : "", dec.coe_text, dec.exp);
+    return buf;
+}
+
+static void to_decnum(const dec_t& dec, decNumber *dn, decContext *ctxp)
+{
+    char buf[100];
+    decNumberFromString(dn, dec_text(dec, buf), ctxp);
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+ * check()
+ *
+ * Divide and compare one pair of operands both ways.  The native result
+ * must be the same decNumber, i.e. have the same coefficient, exponent,
+ * and sign; comparing the scientific strings checks all three.
+ */
+
+static void check(const dec_t& dividend, const dec_t& divisor)
+{
+    // Room for 64 digits; see new_decNumber() in eis_opu.cpp
+    struct { decNumber dn; decNumberUnit extra[32]; } a, b, ref, nat, cmp;
+    decContext context;
+    multics_decContext(context, 0);
+    to_decnum(dividend, &a.dn, &context);
+    to_decnum(divisor, &b.dn, &context);
+
+    char abuf[100], bbuf[100], rbuf[100], nbuf[100];
+    decNumberToString(&a.dn, abuf);
+    decNumberToString(&b.dn, bbuf);
+
+    // DV3D compares the divisor against the dividend
+    decNumberCompare(&cmp.dn, &b.dn, &a.dn, &context);
+    int c_ref = decNumberToInt32(&cmp.dn, &context);
+    int c_nat = dec_compare_native(divisor, dividend);
+    if (c_ref != c_nat) {
+        if (nfail++ < 20)
+            printf("FAIL compare %s %s: decNumber %d, native %d\n", bbuf, abuf, c_ref, c_nat);
+    }
+
+    dec_t quot;
+    if (dec_divide_native(dividend, divisor, quot) != 0) {
+        ++ nskipped;    // DV3D uses decNumber for these
+        return;
+    }
+    multics_decContext(context, 0);
+    decNumberDivide(&ref.dn, &a.dn, &b.dn, &context);
+    decNumberToString(&ref.dn, rbuf);
+    to_decnum(quot, &nat.dn, &context);
+    decNumberToString(&nat.dn, nbuf);
+    if (strcmp(rbuf, nbuf) != 0) {
+        if (nfail++ < 20)
+            printf("FAIL divide %s / %s: decNumber %s, native %s\n", abuf, bbuf, rbuf, nbuf);
+    }
+    ++ nchecked;
+}
+
+// ----------------------------------------------------------------------------
+
+static void random_digits(char *buf, int maxdigits)
+{
+    int n = 1 + rand() % maxdigits;
+    int nlz = rand() % 4 == 0 ? rand() % 4 : 0;
+    int i = 0;
+    for (; i < nlz && i < n - 1; ++i)
+        buf[i] = '0';
+    int style = rand() % 8;
+    for (; i < n; ++i) {
+        // Mostly random digits, with runs of nines and zeros to exercise
+        // carries in the rounding
+        if (style == 0)
+            buf[i] = '9';
+        else if (style == 1 && i > 0)
+            buf[i] = '0';
+        else
+            buf[i] = '0' + rand() % 10;
+    }
+    buf[n] = 0;
+}
+
+int main(int argc, char *argv[])
+{
+    long ncases = (argc > 1) ? atol(argv[1]) : 1000000;
+    unsigned seed = (argc > 2) ? atoi(argv[2]) : 1;
+    srand(seed);
+
+    // Exhaustive: every pair of three digit operands, both signs of the
+    // divisor, and a few exponents
+    char abuf[8], bbuf[8];
+    dec_t a, b;
+    for (int i = 0; i < 1000; ++i)
+        for (int j = 1; j < 1000; ++j)
+            for (int e = -2; e <= 2; e += 2) {
+                sprintf(abuf, "%d", i);
+                sprintf(bbuf, "%03d", j);
+                make_dec(a, abuf, 0, e);
+                make_dec(b, bbuf, j % 2, -e);
+                check(a, b);
+            }
+    printf("Exhaustive: %ld checked, %d failures.\n", nchecked, nfail);
+
+    // Random operands up to the limits of the native path, with exponents
+    // anywhere in the 8-bit range of a floating point operand
+    char adig[40], bdig[40];
+    for (long k = 0; k < ncases; ++k) {
+        random_digits(adig, 38);
+        random_digits(bdig, 37);
+        if (strspn(bdig, "0") == strlen(bdig))
+            continue;   // DV3D faults on a zero divisor
+        int span = (rand() % 4 == 0) ? 128 : 32;
+        make_dec(a, adig, rand() % 2, rand() % (2 * span) - span);
+        make_dec(b, bdig, rand() % 2, rand() % (2 * span) - span);
+        check(a, b);
+    }
+    printf("Total: %ld checked, %ld left to decNumber, %d failures.\n", nchecked, nskipped, nfail);
+    return nfail != 0;
+}
@@ -1,10 +1,13 @@
 /*
     disk.c -- disk drives
 
-    This is just a sketch; the emulator does not yet handle disks.
-
     See manual AN87
 
+    Disk images hold 36-bit words packed two to nine bytes, as in memory
+    dumps.  They are sparse files mapped into memory when attached, and
+    data moves directly between the mapping and main memory.  Only the
+    geometry of a 3381 with 512 word sectors is supported.
+
 */
 /*
    Copyright (c) 2007-2013 Michael Mondy
@@ -15,11 +18,36 @@
    at http://example.org/project/LICENSE.
 */
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "hw6180.h"
-#include "bitstream.h"
 
 extern iom_t iom;
 
+// 3381 -- see the notes with disk_dev in hw6180_cpu.c
+#define DISK_SECTOR_WORDS 512
+#define DISK_SECTORS 451858
+#define DISK_WORDS ((t_uint64) DISK_SECTORS * DISK_SECTOR_WORDS)
+#define DISK_BYTES (DISK_WORDS / 2 * 9)
+#define DISK_SECTOR_BYTES (DISK_SECTOR_WORDS / 2 * 9)
+
+// Sectors the host is asked to start reading at a seek or read command
+#define DISK_PREFETCH_SECTORS 16
+
+static struct s_disk_state {
+    // BUG: An array index by channel doesn't allow multiple disks per channel
+    enum { no_mode, seek_mode, read_mode, write_mode, status_mode } io_mode;
+    uint sector;        // from the last seek
+    uint nwords;        // words moved since the read or write command
+} disk_state[ARRAY_SIZE(iom.channels)];
+
+// An attached disk image; hangs off of the unit's up7
+struct s_disk_map {
+    uint8 *base;
+    size_t len;         // may be short of DISK_BYTES for read-only images
+};
+
 /*
  * disk_init()
  *
@@ -27,7 +55,120 @@ extern iom_t iom;
 
 void disk_init()
 {
-    // Nothing needed
+    memset(disk_state, 0, sizeof(disk_state));
+}
+
+// ============================================================================
+
+/*
+ * disk_attach()
+ *
+ * Attach routine for the disk device.  A writable image is extended to
+ * full size, as a sparse file, and mapped shared so that writes go to the
+ * file.  A new image reads as all zeros.
+ */
+
+t_stat disk_attach(UNIT *uptr, char *cptr)
+{
+    const char *moi = "DISK::attach";
+    t_stat ret = attach_unit(uptr, cptr);
+    if (ret != SCPE_OK)
+        return ret;
+
+    int ro = (uptr->flags & UNIT_RO) != 0;
+    int fd = fileno(uptr->fileref);
+    struct stat sbuf;
+    if (fstat(fd, &sbuf) != 0) {
+        log_msg(ERR_MSG, moi, "Cannot stat %s: %s\n", cptr, strerror(errno));
+        detach_unit(uptr);
+        return SCPE_IOERR;
+    }
+    size_t len = sbuf.st_size;
+    if (! ro && len < DISK_BYTES) {
+        if (ftruncate(fd, DISK_BYTES) != 0) {
+            log_msg(ERR_MSG, moi, "Cannot extend %s: %s\n", cptr, strerror(errno));
+            detach_unit(uptr);
+            return SCPE_IOERR;
+        }
+        len = DISK_BYTES;
+    } else if (len > DISK_BYTES)
+        len = DISK_BYTES;
+
+    struct s_disk_map *mapp = calloc(1, sizeof(*mapp));
+    if (mapp == NULL) {
+        detach_unit(uptr);
+        return SCPE_MEM;
+    }
+    if (len != 0) {
+        void *addr = mmap(NULL, len, (ro) ? PROT_READ : PROT_READ | PROT_WRITE, MAP_SHARED | MAP_NORESERVE, fd, 0);
+        if (addr == MAP_FAILED) {
+            log_msg(ERR_MSG, moi, "Cannot mmap %s: %s\n", cptr, strerror(errno));
+            free(mapp);
+            detach_unit(uptr);
+            return SCPE_IOERR;
+        }
+        mapp->base = addr;
+        mapp->len = len;
+    }
+    uptr->up7 = mapp;
+    log_msg(INFO_MSG, moi, "Attached %s%s; %u sectors of %d words.\n",
+        cptr, (ro) ? " read-only" : "", DISK_SECTORS, DISK_SECTOR_WORDS);
+    return SCPE_OK;
+}
+
+t_stat disk_detach(UNIT *uptr)
+{
+    struct s_disk_map *mapp = uptr->up7;
+    if (mapp != NULL) {
+        if (mapp->base != NULL)
+            munmap(mapp->base, mapp->len);
+        free(mapp);
+        uptr->up7 = NULL;
+    }
+    return detach_unit(uptr);
+}
+
+// ============================================================================
+
+/*
+ * disk_prefetch()
+ *
+ * Ask the host to start reading the sectors at and after the given one
+ * into the mapping.  This is only a hint.  Status is still reported after
+ * the usual fixed delay, so emulated timing does not depend on the host,
+ * and a data DCW that gets there before the kernel does will fault the
+ * pages in on the CPU thread.
+ */
+
+static void disk_prefetch(const struct s_disk_map *mapp, uint sector)
+{
+    if (mapp == NULL || mapp->base == NULL)
+        return;
+    size_t lo = (size_t) sector * DISK_SECTOR_BYTES;
+    size_t hi = lo + DISK_PREFETCH_SECTORS * DISK_SECTOR_BYTES;
+    if (hi > mapp->len)
+        hi = mapp->len;
+    lo &= ~ (size_t) (sysconf(_SC_PAGESIZE) - 1);   // madvise() wants page alignment
+    if (lo < hi)
+        (void) madvise(mapp->base + lo, hi - lo, MADV_WILLNEED);
+}
+
+// ============================================================================
+
+/*
+ * disk_cmd_done()
+ *
+ * Common completion for commands, all of which report status after a
+ * short delay.
+ */
+
+static int disk_cmd_done(chan_devinfo* devinfop, int major, int sub)
+{
+    devinfop->major = major;
+    devinfop->substatus = sub;
+    devinfop->time = 4;
+    devinfop->have_status = 0;
+    return 0;
 }
 
 /*
@@ -81,7 +222,14 @@ int disk_iom_cmd(chan_devinfo* devinfop)
     }
     UNIT* unitp = &devp->units[dev_code];
 
-    // TODO: handle cmd etc for given unit
+    // BUG: Assumes one drive per channel
+    struct s_disk_state *disk_statep = &disk_state[chan];
+    if (disk_statep->io_mode == read_mode || disk_statep->io_mode == write_mode) {
+        // Without a new seek, continue after the last sector touched
+        disk_statep->sector += (disk_statep->nwords + DISK_SECTOR_WORDS - 1) / DISK_SECTOR_WORDS;
+    }
+    disk_statep->io_mode = no_mode;
+    disk_statep->nwords = 0;
 
     switch(dev_cmd) {
         // idcw.command values:
@@ -96,6 +244,52 @@ int disk_iom_cmd(chan_devinfo* devinfop)
         //  051 write alert
         //  057 maybe read id
         //  072 unload -- disk_control.list
+        case 000:       // CMD 00 -- Request Status
+        case 072:       // CMD 72 -- Unload
+            log_msg(INFO_MSG, moi, "%s.\n", (dev_cmd == 0) ? "Request status" : "Unload");
+            return disk_cmd_done(devinfop, 0, 0);
+        case 042:       // CMD 42 -- Restore Access Arm
+            log_msg(INFO_MSG, moi, "Restore access arm.\n");
+            disk_statep->sector = 0;
+            return disk_cmd_done(devinfop, 0, 0);
+        case 022:       // CMD 22 -- Read Status Register
+            // BUG: We have no status register bits to report; the IOM gets
+            // zeros
+            disk_statep->io_mode = status_mode;
+            return disk_cmd_done(devinfop, 0, 0);
+        case 030:       // CMD 30 -- Seek512
+            // The sector number follows in a one word data DCW
+            disk_statep->io_mode = seek_mode;
+            devinfop->is_read = 0;
+            return disk_cmd_done(devinfop, 0, 0);
+        case 023:       // CMD 23 -- Read ASCII
+        case 025:       // CMD 25 -- Read
+        case 031:       // CMD 31 -- Write
+        case 033: {     // CMD 33 -- Write ASCII
+            // ASCII is just a way of looking at the words; the data moves
+            // the same way
+            int is_read = dev_cmd == 023 || dev_cmd == 025;
+            if (unitp->up7 == NULL) {
+                log_msg(WARN_MSG, moi, "No disk image attached to unit %d of channel 0%o.\n", dev_code, chan);
+                devinfop->have_status = 1;
+                *majorp = 02;   // BUG: arbitrary error code; device attention?
+                *subp = 1;
+                return 1;
+            }
+            if (! is_read && (unitp->flags & UNIT_RO)) {
+                log_msg(WARN_MSG, moi, "Disk on channel 0%o is read-only.\n", chan);
+                devinfop->have_status = 1;
+                *majorp = 03;   // BUG: arbitrary error code; data alert?
+                *subp = 1;
+                return 1;
+            }
+            log_msg(INFO_MSG, moi, "%s at sector %u.\n", (is_read) ? "Read" : "Write", disk_statep->sector);
+            disk_statep->io_mode = (is_read) ? read_mode : write_mode;
+            devinfop->is_read = is_read;
+            if (is_read)
+                disk_prefetch(unitp->up7, disk_statep->sector);
+            return disk_cmd_done(devinfop, 0, 0);
+        }
         case 040:       // CMD 40 -- Reset Status
             log_msg(NOTIFY_MSG, moi, "Reset Status.\n");
             *majorp = 0;
@@ -110,7 +304,6 @@ int disk_iom_cmd(chan_devinfo* devinfop)
             //
             return 0;
         default: {
-            log_msg(ERR_MSG, moi, "DISK devices not implemented.\n");
             devinfop->have_status = 1;
             *majorp = 05;       // Command reject
             *subp = 1;          // invalid opcode
@@ -124,12 +317,37 @@ int disk_iom_cmd(chan_devinfo* devinfop)
 
 // ============================================================================
 
+/*
+ * disk_iom_io()
+ *
+ * Transfer a single word; see disk_iom_io_block().
+ */
 
-int disk_iom_io(int chan, t_uint64 *wordp, int* majorp, int* subp)
+int disk_iom_io(chan_devinfo* devinfop, t_uint64 *wordp)
+{
+    uint n;
+    return disk_iom_io_block(devinfop, wordp, 1, &n);
+}
+
+/*
+ * disk_iom_io_block()
+ *
+ * Transfer up to n words between the disk and wordsp, which is normally
+ * main memory itself.  Successive data DCWs of a read or write continue
+ * where the last one stopped.  The number of words moved is returned via
+ * countp, and status is set once for the whole transfer.  Returns non-zero
+ * (out of band) if fewer than n words could be moved.
+ */
+
+int disk_iom_io_block(chan_devinfo* devinfop, t_uint64 *wordsp, uint n, uint *countp)
 {
     const char* moi = "DISK::iom_io";
-    // log_msg(DEBUG_MSG, moi, "Chan 0%o\n", chan);
+    *countp = 0;
+    int chan = devinfop->chan;
+    int* majorp = &devinfop->major;
+    int* subp = &devinfop->substatus;
 
+    devinfop->have_status = 1;
     if (chan < 0 || chan >= ARRAY_SIZE(iom.channels)) {
         *majorp = 05;   // Real HW could not be on bad channel
         *subp = 2;
@@ -147,9 +365,69 @@ int disk_iom_io(int chan, t_uint64 *wordp, int* majorp, int* subp)
     UNIT* unitp = devp->units;
     // BUG: no dev_code
 
-    *majorp = 013;  // MPC Device Data Alert
-    *subp = 02;     // Inconsistent command
-    log_msg(ERR_MSG, moi, "Unimplemented.\n");
-    cancel_run(STOP_BUG);
-    return 1;
+    struct s_disk_state *disk_statep = &disk_state[chan];
+    struct s_disk_map *mapp = unitp->up7;
+
+    *majorp = 0;
+    *subp = 0;
+    switch (disk_statep->io_mode) {
+        case seek_mode: {
+            // BUG: Only the low 24 bits are used for the sector number
+            uint sector = getbits36(wordsp[0], 12, 24);
+            if (sector >= DISK_SECTORS) {
+                log_msg(WARN_MSG, moi, "Seek to sector %u is beyond the end of the disk.\n", sector);
+                *majorp = 05;   // BUG: arbitrary error code; command reject?
+                *subp = 010;
+                return 1;
+            }
+            log_msg(DEBUG_MSG, moi, "Seek to sector %u.\n", sector);
+            disk_statep->sector = sector;
+            disk_statep->io_mode = no_mode;
+            disk_prefetch(mapp, sector);
+            *countp = 1;
+            return n != 1;
+        }
+        case status_mode:
+            memset(wordsp, 0, n * sizeof(*wordsp));
+            *countp = n;
+            return 0;
+        case read_mode:
+        case write_mode: {
+            int is_read = disk_statep->io_mode == read_mode;
+            if (mapp == NULL || (! is_read && (unitp->flags & UNIT_RO))) {
+                log_msg(WARN_MSG, moi, "Disk on channel 0%o was detached or made read-only.\n", chan);
+                *majorp = 02;   // BUG: arbitrary error code; device attention?
+                *subp = 1;
+                return 1;
+            }
+            t_uint64 first = (t_uint64) disk_statep->sector * DISK_SECTOR_WORDS + disk_statep->nwords;
+            uint count = n;
+            if (first + count > DISK_WORDS)
+                count = DISK_WORDS - first;
+            if (is_read) {
+                // Words past the end of a short read-only image are zero
+                t_uint64 have = mapp->len / 9 * 2 + (mapp->len % 9 >= 5);
+                uint nmap = (first >= have) ? 0 : (first + count > have) ? have - first : count;
+                if (nmap != 0)
+                    unpack_words(mapp->base, first, nmap, wordsp);
+                memset(wordsp + nmap, 0, (count - nmap) * sizeof(*wordsp));
+            } else
+                pack_words(wordsp, count, mapp->base, first);
+            disk_statep->nwords += count;
+            *countp = count;
+            if (count < n) {
+                log_msg(WARN_MSG, moi, "Transfer runs off the end of the disk.\n");
+                *majorp = 03;   // BUG: arbitrary error code; data alert?
+                *subp = 1;
+                return 1;
+            }
+            return 0;
+        }
+        default:
+            *majorp = 013;  // MPC Device Data Alert
+            *subp = 02;     // Inconsistent command
+            log_msg(ERR_MSG, moi, "Data transfer without a seek, read, or write command.\n");
+            cancel_run(STOP_BUG);
+            return 1;
+    }
 }
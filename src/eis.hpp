@@ -53,9 +53,10 @@ private:
         unsigned lo;    // absolute
         unsigned hi;    // absolute
         int _offset;    // offset within page used to generate addr member
+        bool direct;    // lo .. hi may be accessed directly in Mem[]
         int valid() const { return _valid && addr >= lo && addr <= hi; }
         // int valid(int offset) const;
-        page_t() { _valid = 0; _offset = 0; }
+        page_t() { _valid = 0; _offset = 0; direct = 0; }
     } page;
     void _bit_advance(int nbits, bool quiet);
 public:
@@ -80,6 +81,10 @@ public:
     int _bitno() const { return _bitnum; }
     int char_charno() const { return page.valid() ? (int) _bitnum / 9 : -1; }
     int char_bitno() const { return page.valid() ? (int) _bitnum % 9 : -1; }
+    // Current word in Mem[], or NULL if it must be accessed via
+    // fetch_abs_word() and store_abs_word()
+    t_uint64* mem() const {
+        return (page.direct && page.valid() && page.addr < MAXMEMSIZE) ? &Mem[page.addr] : NULL; }
     int get();
     // int get(unsigned* addrp, unsigned* bitnop, unsigned* minp, unsigned* maxp);
 };
@@ -125,9 +130,19 @@ private:
         int lo_write;
         int hi_write;
     } buf;
+    struct {
+        // words stored directly into Mem[] but not yet reported via
+        // mem_stored(); absolute addresses or -1
+        int lo;
+        int hi;
+    } dirty;
     int _get(unsigned* valp, bool want_advance);
     int _put(unsigned val, bool want_advance);
+    int fetch_curr(t_uint64 *wordp);
+    int store_curr(t_uint64 word);
+    void commit();
 public:
+    virtual ~desc_t() { commit(); }
     // desc_t(); -- no constructor for abstract base class; use init()
     void init(const eis_mf_t& mf, int y_addr, int width, int cn, int bit_offset, int nchar, int is_fwd);
     void mod64() {          // adjust length to be modulo 64
@@ -143,6 +158,10 @@ public:
     int val(unsigned* valp)  // read, no advance
         { return _get(valp, 0); }
     int flush(int verbose = 1);  // write buffer to main memory
+    int bulk_span(t_uint64 *curp);  // chars accessible in place; see eis_desc.cpp
+    void bulk_done(int nchars);     // advance past chars handled in place
+    int bulk_move(desc_t& dest);    // copy a run of chars a word at a time
+    int bulk_fill(unsigned val);    // fill a run of chars a word at a time
     virtual char* to_text(char *buf) const = 0;
     int init_ptr();
     int valid() const { return _curr.valid(); }
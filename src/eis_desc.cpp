@@ -403,6 +403,8 @@ void desc_t::init(const eis_mf_t& mf, int y_addr, int width, int cn, int bit_off
     buf.is_loaded = 0;
     buf.lo_write = -1;
     buf.hi_write = -1;
+    dirty.lo = -1;
+    dirty.hi = -1;
 
 }
 
@@ -578,9 +580,8 @@ void ptr_t::set(bool ar, unsigned reg, int width, unsigned y)
 {
     initial.abs = get_addr_mode() == ABSOLUTE_mode;
     if (initial.abs) {
-        // Since bounds never change in absolute mode, get() doesn't maintain these
-        // and we initialize them here
-        // set
+        // There is no translation in absolute mode, but get() still moves
+        // the bounds along a page at a time; see ptr_t::get()
         page._valid = 1;
         page._offset = y;
         page.lo = 0;
@@ -658,8 +659,13 @@ int ptr_t::get()
     const char* moi = "APU::EIS::addr::get";
 
     if (initial.abs) {
-        // no translation
+        // No translation.  Bounds are kept to the surrounding 1024 word
+        // page so that the direct access check covers only words the
+        // descriptor can reach before it calls us again.
         page.addr = page._offset;
+        page.lo = page.addr & ~ 01777;
+        page.hi = page.lo + 01777;
+        page.direct = mem_direct_ok(page.lo, page.hi);
         return 0;
     }
 
@@ -673,8 +679,10 @@ int ptr_t::get()
         log_msg(ERR_MSG, moi, "Failed to translate eis address.\n");
         cancel_run(STOP_IBKPT);
         return 1;
-    } else
+    } else {
         page._valid = 1;
+        page.direct = mem_direct_ok(page.lo, page.hi);
+    }
 
     // Sanity check -- but only on pages other than the first page
     if (page._offset != 0) {
@@ -857,7 +865,7 @@ int desc_t::_get(unsigned* valp, bool want_advance)
             }
         }
         // Read the word
-        if (fetch_abs_word(_curr.addr(), &buf.word) != 0) {
+        if (fetch_curr(&buf.word) != 0) {
             log_msg(WARN_MSG, moi, "Failed: fetch word %#o\n", _curr.addr());
             cancel_run(STOP_WARN);
             return 1;
@@ -952,7 +960,8 @@ int desc_t::init_ptr()
     }
 
     if (! _is_fwd) {
-        log_msg(INFO_MSG, moi, "Reverse descriptor with %d chars; advancing %d chars.\n", _n, (_n > 0) ? _n - 1 : 0);
+        if (opt_debug)
+            log_msg(DEBUG_MSG, moi, "Reverse descriptor with %d chars; advancing %d chars.\n", _n, (_n > 0) ? _n - 1 : 0);
         if (_n > 0)
             _curr.char_advance(_n - 1);
     }
@@ -1023,7 +1032,7 @@ int desc_t::_put(unsigned val, bool want_advance)
             // all of it
             // BUG: Don't merge.  Instead, use buf.lo_write and buf.hi_write
             // and handle in flush()
-            if (fetch_abs_word(_curr.addr(), &buf.word) != 0) {
+            if (fetch_curr(&buf.word) != 0) {
                 log_msg(WARN_MSG, moi, "Failed.\n");
                 return 1;
             }
@@ -1177,7 +1186,7 @@ int desc_t::flush(int verbose)
         // only have unwritten bits at either the front or the back, not
         // the middle.
         t_uint64 word;
-        if (fetch_abs_word(_curr.addr(), &word) != 0) {
+        if (fetch_curr(&word) != 0) {
             log_msg(WARN_MSG, moi, "Failed.\n");
             return 1;
         }
@@ -1195,7 +1204,7 @@ int desc_t::flush(int verbose)
     //opt_debug = 1;
     if (opt_debug>0 && verbose)
         log_msg(DEBUG_MSG, moi, "Storing %012llo to addr=%#o.\n", buf.word, _curr.addr());
-    if (store_abs_word(_curr.addr(), buf.word) != 0) {
+    if (store_curr(buf.word) != 0) {
         log_msg(WARN_MSG, moi, "Failed.\n");
         // opt_debug = saved_debug;
         return 1;
@@ -1206,6 +1215,287 @@ int desc_t::flush(int verbose)
 
 //=============================================================================
 
+/*
+ * desc_t::fetch_curr()
+ * desc_t::store_curr()
+ *
+ * Access the word at the current position, directly in Mem[] when the
+ * page allows it.  Direct stores are only collected into the dirty range;
+ * commit() reports them to the CPU in one batch when the range can no
+ * longer be extended and when the descriptor goes away at the end of the
+ * instruction.
+ */
+
+int desc_t::fetch_curr(t_uint64 *wordp)
+{
+    t_uint64 *wp = _curr.mem();
+    if (wp == NULL)
+        return fetch_abs_word(_curr.addr(), wordp);
+    *wordp = *wp;
+    return 0;
+}
+
+int desc_t::store_curr(t_uint64 word)
+{
+    t_uint64 *wp = _curr.mem();
+    if (wp == NULL)
+        return store_abs_word(_curr.addr(), word);
+    *wp = word;
+    int addr = _curr.addr();
+    if (dirty.lo != -1 && (addr < dirty.lo - 1 || addr > dirty.hi + 1))
+        commit();
+    if (dirty.lo == -1 || addr < dirty.lo)
+        dirty.lo = addr;
+    if (dirty.hi == -1 || addr > dirty.hi)
+        dirty.hi = addr;
+    return 0;
+}
+
+void desc_t::commit()
+{
+    if (dirty.lo == -1)
+        return;
+    mem_stored(dirty.lo, dirty.hi);
+    dirty.lo = -1;
+    dirty.hi = -1;
+}
+
+//=============================================================================
+
+/*
+ * store_bits()
+ *
+ * Store the low n bits of val into the absolute word at addr starting at
+ * bit position bitno.  Whole words are stored without first being read.
+ */
+
+static int store_bits(uint addr, int bitno, int n, t_uint64 val)
+{
+    t_uint64 word;
+    if (bitno == 0 && n == 36)
+        word = val;
+    else {
+        if (fetch_abs_word(addr, &word) != 0)
+            return 1;
+        int shift = 36 - bitno - n;
+        word = (word & ~ (MASKBITS(n) << shift)) | ((val & MASKBITS(n)) << shift);
+    }
+    return store_abs_word(addr, word);
+}
+
+//-----------------------------------------------------------------------------
+
+/*
+ * copy_bits()
+ *
+ * Copy nbits from one absolute bit address (word * 36 + bit) to another,
+ * working a destination word at a time and shifting source words into
+ * place as needed.  Operands must not overlap.
+ */
+
+static int copy_bits(t_uint64 src, t_uint64 dst, uint nbits)
+{
+    uint sa = src / 36;
+    int sbit = src % 36;
+    uint da = dst / 36;
+    int dbit = dst % 36;
+
+    t_uint64 w0, w1;    // source words at sa and sa + 1
+    bool have0 = 0, have1 = 0;
+    while (nbits > 0) {
+        int n = 36 - dbit;
+        if ((uint) n > nbits)
+            n = nbits;
+        if (! have0) {
+            if (fetch_abs_word(sa, &w0) != 0)
+                return 1;
+            have0 = 1;
+        }
+        t_uint64 bits;
+        if (sbit + n <= 36)
+            bits = (w0 >> (36 - sbit - n)) & MASKBITS(n);
+        else {
+            if (! have1) {
+                if (fetch_abs_word(sa + 1, &w1) != 0)
+                    return 1;
+                have1 = 1;
+            }
+            int n0 = 36 - sbit;
+            int n1 = n - n0;
+            bits = ((w0 & MASKBITS(n0)) << n1) | (w1 >> (36 - n1));
+        }
+        if (store_bits(da, dbit, n, bits) != 0)
+            return 1;
+        nbits -= n;
+        ++ da;
+        dbit = 0;
+        sbit += n;
+        if (sbit >= 36) {
+            sbit -= 36;
+            ++ sa;
+            w0 = w1;
+            have0 = have1;
+            have1 = 0;
+        }
+    }
+    return 0;
+}
+
+//=============================================================================
+
+/*
+ * desc_t::bulk_span()
+ *
+ * Prepare for a bulk transfer.  Returns the number of characters that can
+ * be accessed starting at the current character without leaving the
+ * current page, or zero if the bulk routines cannot be used.   The
+ * absolute bit address of the current character is returned via curp.
+ * Returns -1 on error.
+ */
+
+int desc_t::bulk_span(t_uint64 *curp)
+{
+    const char* moi = "APU::EIS::bulk";
+
+    if (_width == 4 || _n == 0)
+        return 0;
+    if (! ptr_init) {
+        if (init_ptr() != 0) {
+            log_msg(WARN_MSG, moi, "Cannot initialize\n");
+            cancel_run(STOP_WARN);
+            return -1;
+        }
+        ptr_init = 1;
+    }
+    if (buf.lo_write != -1)
+        return 0;       // let put() finish the partially written word
+    if (!valid()) {
+        if (_curr.get() != 0) {
+            log_msg(WARN_MSG, moi, "Cannot advance to next page.\n");
+            cancel_run(STOP_WARN);
+            return -1;
+        }
+    }
+
+    uint addr = _curr.addr();
+    uint bitno = _curr.bitno();
+    *curp = (t_uint64) addr * 36 + bitno;
+    t_uint64 avail;
+    if (_is_fwd)
+        avail = ((t_uint64) (_curr.max() - addr + 1) * 36 - bitno) / _width;
+    else
+        avail = ((t_uint64) (addr - _curr.min()) * 36 + bitno) / _width + 1;
+    return (avail < _n) ? (int) avail : (int) _n;
+}
+
+//-----------------------------------------------------------------------------
+
+/*
+ * desc_t::bulk_done()
+ *
+ * Advance past characters handled by a bulk transfer.  The word buffer
+ * used by get() and put() is discarded.
+ */
+
+void desc_t::bulk_done(int nchars)
+{
+    _curr.char_advance(_is_fwd ? nchars : - nchars);
+    _n -= nchars;
+    buf.word = 0;
+    buf.is_loaded = 0;
+    buf.lo_write = -1;
+    buf.hi_write = -1;
+}
+
+//-----------------------------------------------------------------------------
+
+/*
+ * desc_t::bulk_move()
+ *
+ * Copy as many characters as possible from this descriptor to the given
+ * destination without leaving the current page of either operand.  Only
+ * used when both operands have the same width (other than 4-bit) and
+ * direction and do not overlap; short runs are also declined.  Returns
+ * the number of characters moved, zero if the caller should move the next
+ * character via get() and put(), or -1 on error.
+ */
+
+int desc_t::bulk_move(desc_t& dest)
+{
+    if (_width != dest._width || _is_fwd != dest._is_fwd)
+        return 0;
+    t_uint64 src, dst;
+    int n = bulk_span(&src);
+    if (n <= 0)
+        return n;
+    int m = dest.bulk_span(&dst);
+    if (m <= 0)
+        return m;
+    if (m < n)
+        n = m;
+    uint nbits = n * _width;
+    if (nbits < 72)
+        return 0;
+    if (! _is_fwd) {
+        src -= nbits - _width;
+        dst -= nbits - _width;
+    }
+    // Overlapping operands must see each character as it is stored
+    if (src / 36 <= (dst + nbits - 1) / 36 && dst / 36 <= (src + nbits - 1) / 36)
+        return 0;
+
+    if (copy_bits(src, dst, nbits) != 0)
+        return -1;
+    bulk_done(n);
+    dest.bulk_done(n);
+    return n;
+}
+
+//-----------------------------------------------------------------------------
+
+/*
+ * desc_t::bulk_fill()
+ *
+ * Store the given character into as many positions as possible without
+ * leaving the current page.  Return values are as for bulk_move().
+ */
+
+int desc_t::bulk_fill(unsigned val)
+{
+    t_uint64 dst;
+    int n = bulk_span(&dst);
+    if (n <= 0)
+        return n;
+    uint nbits = n * _width;
+    if (nbits < 72)
+        return 0;
+    if (! _is_fwd)
+        dst -= nbits - _width;
+
+    // Characters never straddle words, so one word of the pattern
+    // supplies the bits for any position
+    t_uint64 pattern = 0;
+    for (int i = 0; i < 36; i += _width)
+        pattern = (pattern << _width) | (val & MASKBITS(_width));
+
+    uint da = dst / 36;
+    int dbit = dst % 36;
+    for (uint left = nbits; left > 0; ) {
+        int k = 36 - dbit;
+        if ((uint) k > left)
+            k = left;
+        if (store_bits(da, dbit, k, pattern >> (36 - dbit - k)) != 0)
+            return -1;
+        left -= k;
+        ++ da;
+        dbit = 0;
+    }
+    bulk_done(n);
+    return n;
+}
+
+//=============================================================================
+
 /*
  * addr_mod_eis_addr_reg()
  *
@@ -59,6 +59,16 @@ int op_move_alphanum(const instr_t* ip, int fwd)
     int ret = 0;
 
     while (desc2.n() > 0) {
+        // Whole runs within a page go a word at a time
+        int nmoved = (desc1.n() == 0) ?
+            desc2.bulk_fill(fill & MASKBITS(desc2.width())) :
+            desc1.bulk_move(desc2);
+        if (nmoved < 0) {
+            ret = 2;
+            break;
+        }
+        if (nmoved > 0)
+            continue;
         uint nib;
         if (desc1.n() == 0)
             nib = fill & MASKBITS(desc2.width());
@@ -96,19 +106,208 @@ int op_move_alphanum(const instr_t* ip, int fwd)
 
 // ============================================================================
 
-static int get_table_char(uint addr, uint index, uint *charp)
+/*
+ * Translation table used by TCT, TCTR, and MVT.  Each word of the table is
+ * fetched on first use and kept for the rest of the instruction.
+ */
+
+class xlate_table_t {
+private:
+    uint _addr;
+    t_uint64 words[512 / 4];    // 9 bit entries
+    uint8 loaded[512 / 4];
+public:
+    xlate_table_t(uint addr) { _addr = addr; memset(loaded, 0, sizeof(loaded)); }
+    int get(uint index, uint *charp);
+};
+
+int xlate_table_t::get(uint index, uint *charp)
+{
+    index &= MASKBITS(9);
+    uint i = index / 4;
+    if (! loaded[i]) {
+        // BUG: assumes entire table fits in same page
+        if (fetch_abs_word(_addr + i, &words[i]) != 0)
+            return 1;
+        loaded[i] = 1;
+    }
+    *charp = getbits36(words[i], (index % 4) * 9, 9);
+    return 0;
+}
+
+// ============================================================================
+
+/*
+ * Word-at-a-time support for 9-bit character strings.
+ *
+ * The *9() routines below work on the run of characters that
+ * desc_t::bulk_span() says can be accessed in place, four characters
+ * (one 36-bit chunk) at a time.  Any characters left over, or strings of
+ * other widths, are handled by the caller one character at a time via
+ * desc_t::get().   Each routine returns the number of characters it
+ * advanced the descriptor(s) past, or -1 on error.
+ */
+
+// Replicate a 9-bit character into all four positions of a word
+static inline t_uint64 rep9(uint c)
+{
+    t_uint64 w = c & MASKBITS(9);
+    return (w << 27) | (w << 18) | (w << 9) | w;
+}
+
+// Returns the high bit of each 9-bit lane of x that is zero
+static inline t_uint64 zero_lanes9(t_uint64 x)
 {
-    // index &= MASKBITS(9);
-    addr += index / 4;      // 9 bit entries
-    t_uint64 word;
-    if (fetch_abs_word(addr, &word) != 0) {         // BUG: assumes entire table fits in same page
-        // log_msg(WARN_MSG, "OPU::get-table-char", "Error fetching from addr %#o\n", addr);
+    const t_uint64 low8 = rep9(0377);
+    return ~ (((x & low8) + low8) | x) & rep9(0400);
+}
+
+// Character position (0..3) of the lane holding the given lane high bit
+static inline int lane9(int bit)
+{
+    return (35 - bit) / 9;
+}
+
+// Fetch the 36 bits starting at the given absolute bit address
+static int fetch_chunk9(t_uint64 bitaddr, t_uint64 *valp)
+{
+    uint addr = bitaddr / 36;
+    int bitno = bitaddr % 36;
+    t_uint64 w0, w1;
+    if (fetch_abs_word(addr, &w0) != 0)
         return 1;
+    if (bitno == 0) {
+        *valp = w0;
+        return 0;
     }
-    *charp = getbits36(word, (index % 4) * 9, 9);
+    if (fetch_abs_word(addr + 1, &w1) != 0)
+        return 1;
+    *valp = ((w0 << bitno) | (w1 >> (36 - bitno))) & MASK36;
     return 0;
 }
 
+// Absolute bit address of the k'th chunk of a run starting at bit address
+// cur.  Reverse runs extend downwards from (and include) the character at
+// cur.
+static inline t_uint64 chunk9_addr(t_uint64 cur, int k, int fwd)
+{
+    return fwd ? cur + 36 * k : cur - 27 - 36 * k;
+}
+
+/*
+ * scan9()
+ *
+ * Skip over characters not matching the given test character under the
+ * given mask (SCM and SCMR).  Sets *foundp and stops at the first match.
+ */
+
+static int scan9(desc_t& desc, int fwd, uint test, uint mask, int *foundp)
+{
+    *foundp = 0;
+    t_uint64 cur;
+    int n = desc.bulk_span(&cur);
+    if (n < 4)
+        return (n < 0) ? -1 : 0;
+
+    const t_uint64 want = rep9(test);
+    const t_uint64 care = rep9(~mask);
+    int k;
+    for (k = 0; k < n / 4; ++k) {
+        t_uint64 w;
+        if (fetch_chunk9(chunk9_addr(cur, k, fwd), &w) != 0)
+            return -1;
+        t_uint64 z = zero_lanes9((w ^ want) & care);
+        if (z != 0) {
+            // forward wants the leftmost match, reverse the rightmost
+            int skip = fwd ? lane9(63 - __builtin_clzll(z)) : 3 - lane9(__builtin_ctzll(z));
+            skip += 4 * k;
+            desc.bulk_done(skip);
+            *foundp = 1;
+            return skip;
+        }
+    }
+    desc.bulk_done(4 * k);
+    return 4 * k;
+}
+
+/*
+ * cmp9()
+ *
+ * Skip over leading characters that are equal in two forward descriptors,
+ * or, if desc2 is NULL, that equal the given fill character (CMPC).  Stops
+ * at the chunk holding the first difference.
+ */
+
+static int cmp9(desc_t& desc1, desc_t* desc2p, uint fill)
+{
+    t_uint64 cur1, cur2;
+    int n = desc1.bulk_span(&cur1);
+    if (n < 4)
+        return (n < 0) ? -1 : 0;
+    if (desc2p != NULL) {
+        int n2 = desc2p->bulk_span(&cur2);
+        if (n2 < 4)
+            return (n2 < 0) ? -1 : 0;
+        if (n2 < n)
+            n = n2;
+    }
+
+    const t_uint64 pattern = rep9(fill);
+    int k;
+    for (k = 0; k < n / 4; ++k) {
+        t_uint64 w1, w2;
+        if (fetch_chunk9(cur1 + 36 * k, &w1) != 0)
+            return -1;
+        if (desc2p == NULL)
+            w2 = pattern;
+        else if (fetch_chunk9(cur2 + 36 * k, &w2) != 0)
+            return -1;
+        if (w1 != w2)
+            break;
+    }
+    if (k != 0) {
+        desc1.bulk_done(4 * k);
+        if (desc2p != NULL)
+            desc2p->bulk_done(4 * k);
+    }
+    return 4 * k;
+}
+
+/*
+ * tct9()
+ *
+ * Skip over characters whose translation table entry is zero (TCT and
+ * TCTR).  Stops at the first non-zero entry, which is returned via
+ * *tcharp.
+ */
+
+static int tct9(desc_t& desc, int fwd, xlate_table_t& table, uint *tcharp)
+{
+    *tcharp = 0;
+    t_uint64 cur;
+    int n = desc.bulk_span(&cur);
+    if (n < 4)
+        return (n < 0) ? -1 : 0;
+
+    int k;
+    for (k = 0; k < n / 4; ++k) {
+        t_uint64 w;
+        if (fetch_chunk9(chunk9_addr(cur, k, fwd), &w) != 0)
+            return -1;
+        for (int j = 0; j < 4; ++j) {
+            int pos = fwd ? j : 3 - j;
+            if (table.get((w >> (27 - 9 * pos)) & MASKBITS(9), tcharp) != 0)
+                return -1;
+            if (*tcharp != 0) {
+                desc.bulk_done(4 * k + j);
+                return 4 * k + j;
+            }
+        }
+    }
+    desc.bulk_done(4 * k);
+    return 4 * k;
+}
+
 // ============================================================================
 
 int op_tct(const instr_t* ip, int fwd)
@@ -139,32 +338,48 @@ int op_tct(const instr_t* ip, int fwd)
     log_msg(DEBUG_MSG, moi, "table addr: %#o\n", addr2);
     log_msg(DEBUG_MSG, moi, "result addr: %#o\n", addr3);
 
+    xlate_table_t table(addr2);
     uint n = desc1.n();
-    while (desc1.n() > 0) {
+    uint i = 0;
+    uint tchar = 0;
+    while (i < n) {
+        if (desc1.width() == 9) {
+            int k = tct9(desc1, fwd, table, &tchar);
+            if (k < 0) {
+                log_msg(WARN_MSG, moi, "Unable to read string or table\n");
+                return 1;
+            }
+            i += k;
+            if (tchar != 0)
+                break;
+            if (k > 0)
+                continue;
+        }
         log_msg(DEBUG_MSG, moi, "Remaining length %d\n", desc1.n());
         uint m;
         if (desc1.get(&m) != 0)
             return 1;
-        uint t;
-        if (get_table_char(addr2, m, &t) != 0) {
+        if (table.get(m, &tchar) != 0) {
             log_msg(WARN_MSG, moi, "Unable to read table\n");
             //if (!fwd) { --opt_debug; -- cpu_dev.dctrl; }
             return 1;
         }
-        if (t != 0) {
-            int idx = (fwd) ? n - desc1.n() - 1 : desc1.n();    // reverse scan also stores i-1 not N1-i !
-            int i = n - desc1.n() - 1;
-            log_msg(DEBUG_MSG, moi, "Index %d: found non-zero table entry %#o for table index %#o, from offset %d in the str.\n", i, t, m, idx);
-            t_uint64 word = (t_uint64) t << 27;
-            word = setbits36(word, 12, 24, i);
-            if (store_abs_word(addr3, word) != 0) {
-                //if (!fwd) { --opt_debug; -- cpu_dev.dctrl; }
-                return 1;
-            }
-            IR.tally_runout = 0;
-            PPR.IC += 4;        // BUG: when should we bump IC?  probably not for seg faults, but probably yes for overflow
-            return 0;
+        if (tchar != 0)
+            break;
+        ++ i;
+    }
+    if (tchar != 0) {
+        // reverse scan also stores i-1 not N1-i !
+        log_msg(DEBUG_MSG, moi, "Index %d: found non-zero table entry %#o in the str.\n", i, tchar);
+        t_uint64 word = (t_uint64) tchar << 27;
+        word = setbits36(word, 12, 24, i);
+        if (store_abs_word(addr3, word) != 0) {
+            //if (!fwd) { --opt_debug; -- cpu_dev.dctrl; }
+            return 1;
         }
+        IR.tally_runout = 0;
+        PPR.IC += 4;        // BUG: when should we bump IC?  probably not for seg faults, but probably yes for overflow
+        return 0;
     }
 
     //if (!fwd) { --opt_debug; -- cpu_dev.dctrl; }
@@ -213,6 +428,7 @@ extern int op_mvt(const instr_t* ip)
     log_msg(DEBUG_MSG, moi, "desc2: %s\n", desc2.to_text(buf));
     log_msg(DEBUG_MSG, moi, "translation table at %#llo => %#o\n", word3, addr3);
 
+    xlate_table_t table(addr3);
     int ret = 0;
 
     // uint n = desc1.n;
@@ -226,7 +442,7 @@ extern int op_mvt(const instr_t* ip)
                 break;
             }
         uint t;
-        if (get_table_char(addr3, m, &t) != 0) {
+        if (table.get(m, &t) != 0) {
             log_msg(WARN_MSG, moi, "Unable to read table\n");
             ret = 1;
             break;
@@ -292,7 +508,19 @@ int op_cmpc(const instr_t* ip)
     int ret = 0;
 
     uint nib1, nib2;
+    nib1 = nib2 = 0;
     while (desc1.n() > 0 || desc2.n() > 0) {
+        if (desc1.width() == 9) {
+            // Skip equal chunks; the loop below then finds the exact character
+            int k = (desc1.n() == 0) ? cmp9(desc2, NULL, fill) :
+                (desc2.n() == 0) ? cmp9(desc1, NULL, fill) : cmp9(desc1, &desc2, 0);
+            if (k < 0) {
+                ret = 1;
+                break;
+            }
+            if (k > 0)
+                continue;
+        }
         if (desc1.n() == 0)
             nib1 = fill & MASKBITS(desc1.width());
         else
@@ -682,6 +910,158 @@ int _op_dtb(const instr_t* ip)
 }
 
 
+// ============================================================================
+
+/*
+ * Word-at-a-time support for bit strings.
+ *
+ * As with the *9() routines above, these work on the run that
+ * desc_t::bulk_span() reports, here up to 36 bits per step.  Runs shorter
+ * than a word are left to the caller's bit at a time loop.  Each routine
+ * returns the number of bits it advanced the descriptor(s) past, or -1 on
+ * error.
+ */
+
+// Fetch n (1..36) bits starting at the given absolute bit address, right
+// justified.  Only the word(s) actually holding those bits are fetched.
+static int fetch_bits(t_uint64 bitaddr, int n, t_uint64 *valp)
+{
+    uint addr = bitaddr / 36;
+    int bitno = bitaddr % 36;
+    t_uint64 w0, w1;
+    if (fetch_abs_word(addr, &w0) != 0)
+        return 1;
+    if (bitno + n <= 36) {
+        *valp = (w0 >> (36 - bitno - n)) & MASKBITS(n);
+        return 0;
+    }
+    if (fetch_abs_word(addr + 1, &w1) != 0)
+        return 1;
+    int n0 = 36 - bitno;
+    int n1 = n - n0;
+    *valp = ((w0 & MASKBITS(n0)) << n1) | (w1 >> (36 - n1));
+    return 0;
+}
+
+// Apply a BOLR truth table (see csl) to 36 bit pairs at once
+static inline t_uint64 bolr36(uint bolr, t_uint64 x, t_uint64 y)
+{
+    t_uint64 r = 0;
+    if (bolr & 010)
+        r |= ~x & ~y;
+    if (bolr & 04)
+        r |= ~x & y;
+    if (bolr & 02)
+        r |= x & ~y;
+    if (bolr & 01)
+        r |= x & y;
+    return r & MASK36;
+}
+
+/*
+ * combine_bits()
+ *
+ * Combine a run of bits of desc1 (or of the fill bit once desc1 is
+ * exhausted) with desc2 (CSL, CSR, SZTL, SZTR).   Works a word of desc2 at
+ * a time.  The result replaces desc2 only if store is set.  Sets
+ * *nonzerop if any result bit is a one.  Overlapping operands are
+ * declined so that the caller sees each bit as it is stored.
+ */
+
+static int combine_bits(desc_t& desc1, desc_t& desc2, int fwd, uint fill, uint bolr, int store, int *nonzerop)
+{
+    t_uint64 cur1, cur2;
+    int n = desc2.bulk_span(&cur2);
+    if (n < 36)
+        return (n < 0) ? -1 : 0;
+    int have1 = desc1.n() > 0;
+    if (have1) {
+        int n1 = desc1.bulk_span(&cur1);
+        if (n1 < 36)
+            return (n1 < 0) ? -1 : 0;
+        if (n1 < n)
+            n = n1;
+    }
+    // Reverse runs extend downwards from (and include) the current bit
+    t_uint64 lo1 = fwd ? cur1 : cur1 - (n - 1);
+    t_uint64 lo2 = fwd ? cur2 : cur2 - (n - 1);
+    if (have1 && store)
+        if (lo1 / 36 <= (lo2 + n - 1) / 36 && lo2 / 36 <= (lo1 + n - 1) / 36)
+            return 0;
+
+    const t_uint64 fillbits = fill ? MASK36 : 0;
+    for (int done = 0; done < n; ) {
+        uint addr = (lo2 + done) / 36;
+        int bitno = (lo2 + done) % 36;
+        int k = 36 - bitno;
+        if (k > n - done)
+            k = n - done;
+        t_uint64 word, x;
+        if (fetch_abs_word(addr, &word) != 0)
+            return -1;
+        if (! have1)
+            x = fillbits;
+        else if (fetch_bits(lo1 + done, k, &x) != 0)
+            return -1;
+        int shift = 36 - bitno - k;
+        t_uint64 mask = MASKBITS(k) << shift;
+        t_uint64 r = bolr36(bolr, x << shift, word) & mask;
+        if (r != 0)
+            *nonzerop = 1;
+        if (store)
+            if (store_abs_word(addr, (word & ~ mask) | r) != 0)
+                return -1;
+        done += k;
+    }
+    if (have1)
+        desc1.bulk_done(n);
+    desc2.bulk_done(n);
+    return n;
+}
+
+/*
+ * cmp_bits()
+ *
+ * Skip over leading bits that are equal in two forward descriptors, or,
+ * if desc2 is NULL, that equal the fill bit (CMPB).  Stops at the word
+ * holding the first difference.
+ */
+
+static int cmp_bits(desc_t& desc1, desc_t* desc2p, uint fill)
+{
+    t_uint64 cur1, cur2;
+    int n = desc1.bulk_span(&cur1);
+    if (n < 36)
+        return (n < 0) ? -1 : 0;
+    if (desc2p != NULL) {
+        int n2 = desc2p->bulk_span(&cur2);
+        if (n2 < 36)
+            return (n2 < 0) ? -1 : 0;
+        if (n2 < n)
+            n = n2;
+    }
+
+    const t_uint64 fillbits = fill ? MASK36 : 0;
+    int k;
+    for (k = 0; k < n / 36; ++k) {
+        t_uint64 w1, w2;
+        if (fetch_bits(cur1 + 36 * k, 36, &w1) != 0)
+            return -1;
+        if (desc2p == NULL)
+            w2 = fillbits;
+        else if (fetch_bits(cur2 + 36 * k, 36, &w2) != 0)
+            return -1;
+        if (w1 != w2)
+            break;
+    }
+    if (k != 0) {
+        desc1.bulk_done(36 * k);
+        if (desc2p != NULL)
+            desc2p->bulk_done(36 * k);
+    }
+    return 36 * k;
+}
+
 // ============================================================================
 
 int op_cmpb(const instr_t* ip)
@@ -703,10 +1083,12 @@ int op_cmpb(const instr_t* ip)
 
     bit_desc_t desc1(ip->mods.mf1, word1, 1);
     bit_desc_t desc2(mf2, word2, 1);
-    char buf[100];
-    log_msg(DEBUG_MSG, moi, "desc1: %s\n", desc1.to_text(buf));
-    log_msg(DEBUG_MSG, moi, "desc2: %s\n", desc2.to_text(buf));
-    log_msg(DEBUG_MSG, moi, "fill bit %d\n", fill);
+    if (opt_debug) {
+        char buf[100];
+        log_msg(DEBUG_MSG, moi, "desc1: %s\n", desc1.to_text(buf));
+        log_msg(DEBUG_MSG, moi, "desc2: %s\n", desc2.to_text(buf));
+        log_msg(DEBUG_MSG, moi, "fill bit %d\n", fill);
+    }
 
     int ret = 0;
 
@@ -714,6 +1096,15 @@ int op_cmpb(const instr_t* ip)
     int zero = 1;
     int carry = 1;
     while (desc1.n() > 0 || desc2.n() > 0) {
+        // Skip equal words; the loop below then finds the exact bit
+        int k = (desc1.n() == 0) ? cmp_bits(desc2, NULL, fill) :
+            (desc2.n() == 0) ? cmp_bits(desc1, NULL, fill) : cmp_bits(desc1, &desc2, 0);
+        if (k < 0) {
+            ret = 1;
+            break;
+        }
+        if (k > 0)
+            continue;
         if (desc1.n() == 0)
             nib1 = fill & MASKBITS(desc1.width());
         else
@@ -806,7 +1197,20 @@ int op_scm(const instr_t* ip, int fwd)
     int ret = 0;
     uint n = desc1.n();
     uint i;
-    for (i = 0; i < n; ++i) {
+    for (i = 0; i < n; ) {
+        if (desc1.width() == 9) {
+            int found;
+            int k = scan9(desc1, fwd, test_nib, mask, &found);
+            if (k < 0) {
+                ret = 1;
+                break;
+            }
+            i += k;
+            if (found)
+                break;
+            if (k > 0)
+                continue;
+        }
         uint nib;
         ret = desc1.get(&nib);
         if (ret != 0)
@@ -816,6 +1220,7 @@ int op_scm(const instr_t* ip, int fwd)
             log_msg(DEBUG_MSG, moi, "compare nibble %#o(%+d): value %03o yields %#o\n", i, i, nib, z);
         if (z == 0)
             break;
+        ++ i;
     }
     if (ret == 0) {
         IR.tally_runout = i == n;
@@ -832,11 +1237,18 @@ int op_scm(const instr_t* ip, int fwd)
 
 // ============================================================================
 
-int op_csl(const instr_t* ip)
-{
-    // Combine bit strings left
+/*
+ * combine_bit_strings()
+ *
+ * Common code for CSL, CSR, SZTL, and SZTR.  The "right" variants process
+ * both strings from their rightmost bit via reverse descriptors so that
+ * any fill or truncation applies on the left.  The zero test variants
+ * compute but do not store the result.
+ */
 
-    const char* moi = "OPU::csl";
+static int combine_bit_strings(const instr_t* ip, int fwd, int store)
+{
+    const char* moi = store ? (fwd ? "OPU::csl" : "OPU::csr") : (fwd ? "OPU::sztl" : "OPU::sztr");
 
     cpu.irodd_invalid = 1;
 
@@ -846,24 +1258,33 @@ int op_csl(const instr_t* ip)
     uint mf2bits = ip->addr & MASKBITS(7);
     eis_mf_t mf2;
     (void) parse_mf(mf2bits, &mf2);
-    log_msg(DEBUG_MSG, moi, "mf2 = %s\n", mf2text(&mf2));
-    const char *ops[16] = { "clear", "and", "x&!y", "x", "!x&y", "y", "xor", "or", "!or", "!xor", "!y", "!x&y", "!x", "x|!y", "nand", "set" };
-    log_msg(INFO_MSG, moi, "bool oper: %#o =b%d%d%d%d (%s), fill: %d\n", bolr, (bolr>>3)&1, (bolr>>2)&1, (bolr>>1)&1, bolr&1, ops[bolr], fill);
 
     t_uint64 word1, word2;
     if (fetch_mf_ops(&ip->mods.mf1, &word1, &mf2, &word2, NULL, NULL) != 0)
         return 1;
 
-    char buf[100];
-    bit_desc_t desc1(ip->mods.mf1, word1, 1);
-    log_msg(INFO_MSG, moi, "desc1: %s\n", desc1.to_text(buf));
-    bit_desc_t desc2(mf2, word2, 1);
-    log_msg(INFO_MSG, moi, "desc2: %s\n", desc2.to_text(buf));
+    bit_desc_t desc1(ip->mods.mf1, word1, fwd);
+    bit_desc_t desc2(mf2, word2, fwd);
+    if (opt_debug) {
+        const char *ops[16] = { "clear", "and", "x&!y", "x", "!x&y", "y", "xor", "or", "!or", "!xor", "!y", "!x&y", "!x", "x|!y", "nand", "set" };
+        char buf[100];
+        log_msg(DEBUG_MSG, moi, "mf2 = %s\n", mf2text(&mf2));
+        log_msg(DEBUG_MSG, moi, "bool oper: %#o =b%d%d%d%d (%s), fill: %d\n", bolr, (bolr>>3)&1, (bolr>>2)&1, (bolr>>1)&1, bolr&1, ops[bolr], fill);
+        log_msg(DEBUG_MSG, moi, "desc1: %s\n", desc1.to_text(buf));
+        log_msg(DEBUG_MSG, moi, "desc2: %s\n", desc2.to_text(buf));
+    }
 
     int ret = 0;
 
-    flag_t all_zero = 1;
+    int nonzero = 0;
     while (desc2.n() > 0) {
+        int k = combine_bits(desc1, desc2, fwd, fill, bolr, store, &nonzero);
+        if (k < 0) {
+            ret = 1;
+            break;
+        }
+        if (k > 0)
+            continue;
         flag_t bit1, bit2;
         if (desc1.n() == 0)
             bit1 = fill;
@@ -880,19 +1301,21 @@ int op_csl(const instr_t* ip)
         flag_t r = (bolr >> (3 - ((bit1 << 1) | bit2))) & 1;    // like indexing into a truth table
         if (opt_debug)
             log_msg(DEBUG_MSG, moi, "nbits1=%d, nbits2=%d; %d op(%#o) %d => %d\n", desc1.n(), desc2.n(), bit1, bolr, bit2, r);
-        if (desc2.put(r) != 0) {
-            ret = 1;
+        if (store)
+            ret = desc2.put(r);
+        else
+            ret = desc2.get(&bit2);     // just advance
+        if (ret != 0)
             break;
-        }
         if (r)
-            all_zero = 0;
+            nonzero = 1;
     }
-    if (ret == 0)
+    if (ret == 0 && store)
         // write unsaved data (if any)
         if (desc2.flush() != 0)
             ret = 1;
     if (ret == 0) {
-        IR.zero = all_zero;
+        IR.zero = ! nonzero;
         IR.truncation = desc1.n() > 0;
         if (IR.truncation && t) {
             fault_gen(overflow_fault);  // truncation
@@ -904,6 +1327,18 @@ int op_csl(const instr_t* ip)
     return ret;
 }
 
+int op_csl(const instr_t* ip, int fwd)
+{
+    // Combine bit strings left (or right)
+    return combine_bit_strings(ip, fwd, 1);
+}
+
+int op_sztl(const instr_t* ip, int fwd)
+{
+    // String zero test left (or right)
+    return combine_bit_strings(ip, fwd, 0);
+}
+
 // ============================================================================
 
 // The MVNE and MVE instructions use MOP (EIS micro operations for edit)
@@ -925,6 +1360,19 @@ typedef struct {
 
 static mop_support_t mopinfo;
 
+// A decoded micro operation
+typedef struct {
+    unsigned char mop;      // 5-bit MOP code
+    unsigned char mop_if;   // 4-bit IF field
+    short arg;              // char following LTE or INSB, -1 if missing
+} mop_op_t;
+
+// Initial contents of the edit insertion table
+static const unsigned char mop_default_eit[9] = {
+    0,      // unused
+    ' ', '*', '+', '-', '*', '\'', '.', '0'
+};
+
 // ============================================================================
 
 static int mop_init(num_desc_t *descp, int is_decimal)
@@ -932,15 +1380,7 @@ static int mop_init(num_desc_t *descp, int is_decimal)
 {
     const char *moi = "opu::MOP::init";
 
-    mopinfo.eit[0] = 0;     // unused
-    mopinfo.eit[1] = ' ';
-    mopinfo.eit[2] = '*';
-    mopinfo.eit[3] = '+';
-    mopinfo.eit[4] = '-';
-    mopinfo.eit[5] = '*';
-    mopinfo.eit[6] = '\'';
-    mopinfo.eit[7] = '.';
-    mopinfo.eit[8] = '0';
+    memcpy(mopinfo.eit, mop_default_eit, sizeof(mopinfo.eit));
 
     mopinfo.flags.es = 0;
     mopinfo.flags.sn = 0;   // set on if src is a signed decimal and it is negative
@@ -968,13 +1408,13 @@ static int mop_init(num_desc_t *descp, int is_decimal)
                     }
                     mopinfo.sign = src;
                     mopinfo.flags.sn = mopinfo.sign == 015;     // on if negative
-                    log_msg(INFO_MSG, moi, "Got leading sign %02o (%d)\n", mopinfo.sign, mopinfo.flags.sn);
+                    log_msg(DEBUG_MSG, moi, "Got leading sign %02o (%d)\n", mopinfo.sign, mopinfo.flags.sn);
                     continue;
                 }
             } else if (descp->n() == 1 && descp->width() == 4 && descp->s() == 0  ) {
                 // these second-to-last 4 bits are 1/2 of an 8 bit exponent
                 mopinfo.exp = src << 4;
-                log_msg(INFO_MSG, moi, "Got exp hi four bits %02o\n", src);
+                log_msg(DEBUG_MSG, moi, "Got exp hi four bits %02o\n", src);
                 continue;
             } else if (descp->n() == 0) {
                 // last nibble
@@ -982,10 +1422,10 @@ static int mop_init(num_desc_t *descp, int is_decimal)
                     // decimal with exponent
                     if (descp->width() == 4) {
                         mopinfo.exp |= src; // these last 4 bits are the 2nd 1/2 of an 8 bit exponent
-                        log_msg(INFO_MSG, moi, "Got exp low four bits %02o\n", src);
+                        log_msg(DEBUG_MSG, moi, "Got exp low four bits %02o\n", src);
                     } else {
                         mopinfo.exp = src & 0377;   // 8 bit exponent; AL-39 doesn't mention validation
-                        log_msg(INFO_MSG, moi, "Got exp %02o -> %02o\n", src, src & 0377);
+                        log_msg(DEBUG_MSG, moi, "Got exp %02o -> %02o\n", src, src & 0377);
                     }
                     continue;
                 }
@@ -998,7 +1438,7 @@ static int mop_init(num_desc_t *descp, int is_decimal)
                     }
                     mopinfo.sign = src;
                     mopinfo.flags.sn = mopinfo.sign == 015;     // on if negative
-                    log_msg(INFO_MSG, moi, "Got trailing sign %02o (%d)\n", mopinfo.sign, mopinfo.flags.sn);
+                    log_msg(DEBUG_MSG, moi, "Got trailing sign %02o (%d)\n", mopinfo.sign, mopinfo.flags.sn);
                     continue;
                 }
             }
@@ -1007,11 +1447,11 @@ static int mop_init(num_desc_t *descp, int is_decimal)
         }
     }
 
-    log_msg(INFO_MSG, moi, "N = %d, flags: { es = %d, sn = %d, z = %d, bz = %d }, sign=%#o, exp=%#o(%d)\n",
+    log_msg(DEBUG_MSG, moi, "N = %d, flags: { es = %d, sn = %d, z = %d, bz = %d }, sign=%#o, exp=%#o(%d)\n",
             mopinfo.n_src,
             mopinfo.flags.es, mopinfo.flags.sn, mopinfo.flags.z, mopinfo.flags.bz,
             mopinfo.sign, mopinfo.exp, mopinfo.exp);
-    {
+    if (opt_debug) {
     char msg[4*64+1];
     for (int i = 0; i < mopinfo.n_src; ++i) 
         sprintf(msg + i * 4, " %02o,", mopinfo.src[i] & 0xf);
@@ -1045,10 +1485,12 @@ static int mop_put(alpha_desc_t *dest_descp, int is_decimal, unsigned byte)
             // Caller should fill digits or send specials such as blanks
         }
 
-        if (040 <= byte && byte <= 0176)
-            log_msg(DEBUG_MSG, moi, "Writing %03o '%c'\n", byte, byte);
-        else
-            log_msg(DEBUG_MSG, moi, "Writing %03o\n", byte);
+        if (opt_debug) {
+            if (040 <= byte && byte <= 0176)
+                log_msg(DEBUG_MSG, moi, "Writing %03o '%c'\n", byte, byte);
+            else
+                log_msg(DEBUG_MSG, moi, "Writing %03o\n", byte);
+        }
         if (dest_descp->put(byte) != 0)
             return 1;
         
@@ -1064,29 +1506,58 @@ static int mop_put(alpha_desc_t *dest_descp, int is_decimal, unsigned byte)
 
 // ============================================================================
 
-static int mop_exec_single(alpha_desc_t *mop_descp, alpha_desc_t *dest_descp, int is_decimal)
-{
-    const char *moi = "opu::MOP::exec";
+/*
+ * mop_decode()
+ *
+ * Fetch the next MOP and, for LTE and for INSB with a zero IF field, the
+ * character that follows it.  An operand missing because the MOP string
+ * ends early is flagged with an arg of -1 and faults when executed.
+ */
 
+static int mop_decode(alpha_desc_t *mop_descp, mop_op_t *opp)
+{
     uint mop_byte;
-    if (mop_descp->get(&mop_byte) != 0) {
-        fault_gen(illproc_fault);
+    if (mop_descp->get(&mop_byte) != 0)
         return 1;
+    opp->mop = (mop_byte >> 4) & 037;
+    opp->mop_if = mop_byte & 017;
+    opp->arg = 0;
+    if ((opp->mop == 020 && opp->mop_if != 0 && opp->mop_if <= 8) || (opp->mop == 010 && opp->mop_if == 0)) {
+        uint arg;
+        if (mop_descp->n() == 0)
+            opp->arg = -1;
+        else if (mop_descp->get(&arg) != 0)
+            return 1;
+        else
+            opp->arg = arg;
     }
-    uint mop = (mop_byte >> 4) & 037;
-    uint mop_if = mop_byte & 017;
+    return 0;
+}
+
+// ============================================================================
+
+static int mop_exec_op(const mop_op_t *opp, alpha_desc_t *dest_descp, int is_decimal)
+{
+    const char *moi = "opu::MOP::exec";
+
+    uint mop = opp->mop;
+    uint mop_if = opp->mop_if;
+    uint mop_byte = (mop << 4) | mop_if;
 
-    log_msg(INFO_MSG, moi, "Got MOP {%03o,%02o} %#o\n", mop, mop_if, mop_byte);
+    if (opt_debug)
+        log_msg(DEBUG_MSG, moi, "Got MOP {%03o,%02o} %#o\n", mop, mop_if, mop_byte);
     switch(mop) {
         case 002:   // enf -- End floating suppression
-            log_msg(INFO_MSG, moi, "ENF\n");
+            if (opt_debug)
+                log_msg(DEBUG_MSG, moi, "ENF\n");
             if ((mop_if & 010) == 0) {          // bit zero
                 if (!mopinfo.flags.es) {
                     unsigned sign = mopinfo.eit[(mopinfo.flags.sn) ? 4 : 3];
                     if (mop_put(dest_descp, is_decimal, sign) != 0)
                         return 1;
                     mopinfo.flags.es = 1;
-                    log_msg(INFO_MSG, moi, "flags.es set on.\n");
+                    if (opt_debug)
+                        log_msg(DEBUG_MSG, moi, "flags.es set on.\n");
                 } else {
                     // no action
                 }
@@ -1096,7 +1567,8 @@ static int mop_exec_single(alpha_desc_t *mop_descp, alpha_desc_t *dest_descp, in
                     if (mop_put(dest_descp, is_decimal, sign) != 0)
                         return 1;
                     mopinfo.flags.es = 1;
-                    log_msg(INFO_MSG, moi, "flags.es set on.\n");
+                    if (opt_debug)
+                        log_msg(DEBUG_MSG, moi, "flags.es set on.\n");
                 } else {
                     // no action
                 }
@@ -1107,7 +1579,8 @@ static int mop_exec_single(alpha_desc_t *mop_descp, alpha_desc_t *dest_descp, in
         case 001:   // insm -- insert table entry one multiple
             if (mop_if == 0)
                 mop_if = 16;
-            log_msg(INFO_MSG, moi, "INSM %#o(%dd) for EIT[1]==%#o\n", mop_if, mop_if, mopinfo.eit[1]);
+            if (opt_debug)
+                log_msg(DEBUG_MSG, moi, "INSM %#o(%dd) for EIT[1]==%#o\n", mop_if, mop_if, mopinfo.eit[1]);
             for (uint i = 0; i < mop_if; ++i) {
                 if (mop_put(dest_descp, is_decimal, mopinfo.eit[1]) != 0)
                     return 1;
@@ -1115,38 +1588,32 @@ static int mop_exec_single(alpha_desc_t *mop_descp, alpha_desc_t *dest_descp, in
                     return 0;   // exhaustion of destination is the only normal termination
             }
             break;
-        case 020: { // lte -- load table entry
+        case 020:   // lte -- load table entry
             if (mop_if == 0 || mop_if > 8) {
                 log_msg(INFO_MSG, moi, "LTE with bad IF %d\n", mop_if);
                 fault_gen(illproc_fault);
                 return 1;
             }
-            unsigned int m;
-            if (mop_descp->get(&m) != 0) {
+            if (opp->arg < 0) {
                 fault_gen(illproc_fault);
                 return 1;
             }
-            mopinfo.eit[mop_if] = m;
-            log_msg(INFO_MSG, moi, "LTE: Setting EIT[%d] to %02o\n", mop_if, m);
+            mopinfo.eit[mop_if] = opp->arg;
+            if (opt_debug)
+                log_msg(DEBUG_MSG, moi, "LTE: Setting EIT[%d] to %02o\n", mop_if, opp->arg);
             break;
-        }
         case 006:   // mfls -- move with floating sign insertion
             return mop_copy(dest_descp, is_decimal, mop_byte);
         case 015:   // mvc -- move source chars
             return mop_copy(dest_descp, is_decimal, mop_byte);
         case 004:   // mvzb -- move with zero suppression and blank replacment
-            {
-            extern DEVICE cpu_dev; ++ opt_debug; ++ cpu_dev.dctrl;
-            int ret = mop_copy(dest_descp, is_decimal, mop_byte);
-            -- opt_debug; -- cpu_dev.dctrl;
-            return ret;
-            }
+            return mop_copy(dest_descp, is_decimal, mop_byte);
         case 003:   // ses -- Set End Suppression
             {
             int old_es = mopinfo.flags.es;
             mopinfo.flags.es =  (mop_if & 010) != 0;            // bit zero
-            if (old_es != mopinfo.flags.es)
-                log_msg(INFO_MSG, moi, "flags.es is now %s.\n", (mopinfo.flags.es) ? "on" : "off");
+            if (opt_debug && old_es != mopinfo.flags.es)
+                log_msg(DEBUG_MSG, moi, "flags.es is now %s.\n", (mopinfo.flags.es) ? "on" : "off");
             if ((mop_if & 004) != 0)        // bit one
                 mopinfo.flags.bz = 1;
             break;
@@ -1157,34 +1624,35 @@ static int mop_exec_single(alpha_desc_t *mop_descp, alpha_desc_t *dest_descp, in
                 fault_gen(illproc_fault);
                 return 1;
             }
-            log_msg(INFO_MSG, moi, "INSB: ES==%d, IF==%dd\n", mopinfo.flags.es, mop_if);
+            if (opt_debug)
+                log_msg(DEBUG_MSG, moi, "INSB: ES==%d, IF==%dd\n", mopinfo.flags.es, mop_if);
             unsigned byte;
+            if (mop_if == 0 && opp->arg < 0) {
+                fault_gen(illproc_fault);
+                return 1;
+            }
             if (! mopinfo.flags.es) {
                 byte = mopinfo.eit[1];
-                if (mop_if == 0) {
-                    log_msg(INFO_MSG, moi, "INSB: write EIT[one]==%#o and skip next MOP.\n", mopinfo.eit[1]);
-                    unsigned ignored;
-                    if (mop_descp->get(&ignored) != 0) {
-                        fault_gen(illproc_fault);
-                        return 1;
-                    }
-                } else
-                    log_msg(INFO_MSG, moi, "INSB: write EIT[one]==%#o.\n", mopinfo.eit[1]);
+                if (opt_debug) {
+                    if (mop_if == 0)
+                        log_msg(DEBUG_MSG, moi, "INSB: write EIT[one]==%#o and skip next MOP.\n", mopinfo.eit[1]);
+                    else
+                        log_msg(DEBUG_MSG, moi, "INSB: write EIT[one]==%#o.\n", mopinfo.eit[1]);
+                }
             } else {
                 if (mop_if != 0) {
                     byte = mopinfo.eit[mop_if];
-                    log_msg(INFO_MSG, moi, "INSB: write EIT[IF==%d] which is %#o\n", mop_if, byte);
+                    if (opt_debug)
+                        log_msg(DEBUG_MSG, moi, "INSB: write EIT[IF==%d] which is %#o\n", mop_if, byte);
                 } else {
-                    if (mop_descp->get(&byte) != 0) {
-                        fault_gen(illproc_fault);
-                        return 1;
-                    }
+                    byte = opp->arg;
                     //if (is_decimal && dest_descp->nbits == 9) {
                     //  -- unclear if we should high order fill when pulling from mop string...
                     //  byte &= 0xf;
                     //  byte |= mopinfo.eit[8] & 0x1f0;
                     //}
-                    log_msg(INFO_MSG, moi, "INSB: read next mop (%#o) and write it.\n", byte);
+                    if (opt_debug)
+                        log_msg(DEBUG_MSG, moi, "INSB: read next mop (%#o) and write it.\n", byte);
                 }
             }
             if (mop_put(dest_descp, is_decimal, byte) != 0)
@@ -1201,6 +1669,18 @@ static int mop_exec_single(alpha_desc_t *mop_descp, alpha_desc_t *dest_descp, in
 
 // ============================================================================
 
+static int mop_exec_single(alpha_desc_t *mop_descp, alpha_desc_t *dest_descp, int is_decimal)
+{
+    mop_op_t op;
+    if (mop_decode(mop_descp, &op) != 0) {
+        fault_gen(illproc_fault);
+        return 1;
+    }
+    return mop_exec_op(&op, dest_descp, is_decimal);
+}
+
+// ============================================================================
+
 /*
  *
  * Generic copy used by MOPS MVC, MBZA, MVZB, etc
@@ -1223,7 +1703,8 @@ static int mop_copy(alpha_desc_t *dest_descp, int is_decimal, uint mop_byte)
 
     if (mop_if == 0)
         mop_if = 16;
-    log_msg(INFO_MSG, moi, "%s %#o(%dd)\n", mop_name, mop_if, mop_if);
+    if (opt_debug)
+        log_msg(DEBUG_MSG, moi, "%s %#o(%dd)\n", mop_name, mop_if, mop_if);
 
     for (uint i = 0; i < mop_if; ++i) {
         if (mopinfo.n_src == 0) {
@@ -1243,7 +1724,8 @@ static int mop_copy(alpha_desc_t *dest_descp, int is_decimal, uint mop_byte)
             }
         } else if (mop == 006) {
             // mfls -- move with floating sign insertion
-            log_msg(DEBUG_MSG, moi, "Fetched src %#o\n", src);
+            if (opt_debug)
+                log_msg(DEBUG_MSG, moi, "Fetched src %#o\n", src);
             if (mopinfo.flags.es) {
                 if (is_decimal && dest_descp->width() == 9) {
                     src &= 0xf;
@@ -1252,23 +1734,27 @@ static int mop_copy(alpha_desc_t *dest_descp, int is_decimal, uint mop_byte)
             } else {
                 if (src == 0) {
                     src = mopinfo.eit[1];   // normally " "
-                    log_msg(DEBUG_MSG, moi, "Using EIT[1] == %#o\n", src);
+                    if (opt_debug)
+                        log_msg(DEBUG_MSG, moi, "Using EIT[1] == %#o\n", src);
                 } else {
                     int which = (mopinfo.flags.sn) ? 4 : 3;
                     unsigned sign = mopinfo.eit[which];
-                    log_msg(DEBUG_MSG, moi, "Using sign at EIT[%d] == %#o\n", which, sign);
+                    if (opt_debug)
+                        log_msg(DEBUG_MSG, moi, "Using sign at EIT[%d] == %#o\n", which, sign);
                     if (mop_put(dest_descp, is_decimal, sign) != 0)
                         return 1;
                     // TODO: should we test for destination exhaustion here?
                     mopinfo.flags.es = 1;
-                    log_msg(INFO_MSG, moi, "flags.es set on.\n");
+                    if (opt_debug)
+                        log_msg(DEBUG_MSG, moi, "flags.es set on.\n");
                     src &= 0xf;
                     src |= mopinfo.eit[8] & 0x1f0;
                 }
             }
         } else if (mop == 004) {
             // mvzb -- move with zero suppression and blank replacment
-            log_msg(DEBUG_MSG, moi, "Fetched src %#o\n", src);
+            if (opt_debug)
+                log_msg(DEBUG_MSG, moi, "Fetched src %#o\n", src);
             if (mopinfo.flags.es) {
                 // src unchanged
                 if (is_decimal && dest_descp->width() == 9) {
@@ -1278,7 +1764,8 @@ static int mop_copy(alpha_desc_t *dest_descp, int is_decimal, uint mop_byte)
             } else {
                 if (src == 0) {
                     src = mopinfo.eit[1];   // normally " "
-                    log_msg(DEBUG_MSG, moi, "Using EIT[1] == %#o\n", src);
+                    if (opt_debug)
+                        log_msg(DEBUG_MSG, moi, "Using EIT[1] == %#o\n", src);
                 } else {
                     mopinfo.flags.es = 1;
                     if (is_decimal && dest_descp->width() == 9) {
@@ -1300,6 +1787,81 @@ static int mop_copy(alpha_desc_t *dest_descp, int is_decimal, uint mop_byte)
 
 // ============================================================================
 
+/*
+ * Compiled MOP programs
+ *
+ * The same few edit strings (PL/I picture formats) are used over and
+ * over, so MVNE keeps a small cache of decoded MOP strings keyed by the
+ * absolute bit address of the string.  A cached program is used only if
+ * the words it was decoded from are still unchanged in memory, so stores
+ * to the string need no explicit invalidation.   Only 9-bit MOP strings
+ * that lie within a single page are cached; others are interpreted one
+ * MOP at a time.
+ */
+
+enum { mop_cache_size = 16 };
+enum { mop_max_words = 17 };    // 63 9-bit chars at any starting char position
+
+typedef struct {
+    t_uint64 bitaddr;   // absolute bit address of the first MOP
+    int nchars;         // length of the MOP string; zero if entry is unused
+    int nwords;
+    t_uint64 words[mop_max_words];  // memory the program was decoded from
+    int nops;
+    mop_op_t ops[64];
+} mop_prog_t;
+
+static mop_prog_t mop_cache[mop_cache_size];
+
+/*
+ * mop_compile()
+ *
+ * Return a decoded program for the MOP string via *progp, decoding it if
+ * the cache has no current copy.   Sets *progp to NULL without consuming
+ * the descriptor if the string cannot be cached.
+ */
+
+static int mop_compile(alpha_desc_t *mop_descp, const mop_prog_t **progp)
+{
+    *progp = NULL;
+    if (mop_descp->width() != 9)
+        return 0;
+    t_uint64 cur;
+    int n = mop_descp->bulk_span(&cur);
+    if (n < 0)
+        return 1;
+    if (n == 0 || n != mop_descp->n())
+        return 0;
+
+    uint first = cur / 36;
+    int nwords = (cur % 36 + 9 * n + 35) / 36;
+    t_uint64 words[mop_max_words];
+    for (int i = 0; i < nwords; ++i)
+        if (fetch_abs_word(first + i, &words[i]) != 0)
+            return 1;
+
+    mop_prog_t *p = &mop_cache[(cur / 9) % mop_cache_size];
+    if (p->nchars == n && p->bitaddr == cur && memcmp(p->words, words, nwords * sizeof(words[0])) == 0) {
+        mop_descp->bulk_done(n);
+        *progp = p;
+        return 0;
+    }
+
+    p->nchars = 0;
+    p->nops = 0;
+    while (mop_descp->n() > 0)
+        if (mop_decode(mop_descp, &p->ops[p->nops++]) != 0)
+            return 1;
+    p->bitaddr = cur;
+    p->nwords = nwords;
+    memcpy(p->words, words, nwords * sizeof(words[0]));
+    p->nchars = n;
+    *progp = p;
+    return 0;
+}
+
+// ============================================================================
+
 /*
  *
  * Main work of MVNE and MVE instructions -- execute a list of MOPs
@@ -1312,13 +1874,27 @@ static int mop_execute(alpha_desc_t *mop_descp, alpha_desc_t *dest_descp, int is
 
     int ret = 0;
 
-    while (mop_descp->n() > 0 && dest_descp->n() > 0) {
-        if (mop_exec_single(mop_descp, dest_descp, is_decimal) != 0) {
-            ret = 1;
-            // break;       // BUG
-        }
-        if (ret) log_msg(ERR_MSG, moi, "MOP list %d remaining, dest %d remaining.\n", mop_descp->n(), dest_descp->n());
+    const mop_prog_t *progp;
+    if (mop_compile(mop_descp, &progp) != 0) {
+        fault_gen(illproc_fault);
+        return 1;
     }
+    if (progp != NULL) {
+        for (int i = 0; i < progp->nops && dest_descp->n() > 0; ++i) {
+            if (mop_exec_op(&progp->ops[i], dest_descp, is_decimal) != 0) {
+                ret = 1;
+                // break;       // BUG
+            }
+            if (ret) log_msg(ERR_MSG, moi, "MOP list %d remaining, dest %d remaining.\n", progp->nops - i - 1, dest_descp->n());
+        }
+    } else
+        while (mop_descp->n() > 0 && dest_descp->n() > 0) {
+            if (mop_exec_single(mop_descp, dest_descp, is_decimal) != 0) {
+                ret = 1;
+                // break;       // BUG
+            }
+            if (ret) log_msg(ERR_MSG, moi, "MOP list %d remaining, dest %d remaining.\n", mop_descp->n(), dest_descp->n());
+        }
 
     // write unsaved data (if any)
     // if (ret == 0)    // BUG
@@ -1330,22 +1906,7 @@ static int mop_execute(alpha_desc_t *mop_descp, alpha_desc_t *dest_descp, int is
 
 // ============================================================================
 
-#if 1
-static int _op_mvne(const instr_t* ip);
 int op_mvne(const instr_t* ip)
-{
-    extern DEVICE cpu_dev;
-    int saved_debug = opt_debug;
-    int saved_dctrl = cpu_dev.dctrl;
-    ++ opt_debug; ++ cpu_dev.dctrl;
-    int ret = _op_mvne(ip);
-    opt_debug = saved_debug;
-    cpu_dev.dctrl = saved_dctrl;
-    return ret;
-}
-#endif
-
-int _op_mvne(const instr_t* ip)
 {
     const char* moi = "OPU::mvne";
 
@@ -1356,18 +1917,18 @@ int _op_mvne(const instr_t* ip)
 
     eis_mf_t mf2;
     (void) parse_mf(mf2bits, &mf2);
-    log_msg(DEBUG_MSG, moi, "mf2 = %s\n", mf2text(&mf2));
+    if (opt_debug)
+        log_msg(DEBUG_MSG, moi, "mf2 = %s\n", mf2text(&mf2));
     eis_mf_t mf3;
     (void) parse_mf(mf3bits, &mf3);
-    log_msg(DEBUG_MSG, moi, "mf3 = %s\n", mf2text(&mf3));
+    if (opt_debug)
+        log_msg(DEBUG_MSG, moi, "mf3 = %s\n", mf2text(&mf3));
 
     t_uint64 word1, word2, word3;
     if (fetch_mf_ops(&ip->mods.mf1, &word1, &mf2, &word2, &mf3, &word3) != 0)
         return 1;
 
     num_desc_t desc1(ip->mods.mf1, word1, 1);
-    char msg_buf[100];
-    log_msg(INFO_MSG, moi, "desc1: %s\n", desc1.to_text(msg_buf));
     alpha_desc_t desc2(mf2, word2, 1);
     // NOTE: AL-39 says that the only the lower 6 bits of the lengths
     // may be non-zero, but also says that the lengths are treated
@@ -1376,9 +1937,12 @@ int _op_mvne(const instr_t* ip)
     desc2.mod64();
     alpha_desc_t desc3(mf3, word3, 1);
     desc3.mod64();
-    char buf[100];
-    log_msg(INFO_MSG, moi, "desc2: %s\n", desc2.to_text(buf));
-    log_msg(INFO_MSG, moi, "desc3: %s\n", desc3.to_text(buf));
+    if (opt_debug) {
+        char buf[100];
+        log_msg(DEBUG_MSG, moi, "desc1: %s\n", desc1.to_text(buf));
+        log_msg(DEBUG_MSG, moi, "desc2: %s\n", desc2.to_text(buf));
+        log_msg(DEBUG_MSG, moi, "desc3: %s\n", desc3.to_text(buf));
+    }
 
     int ret = 0;
     // Initialize the EIT and load the source bytes
@@ -1415,43 +1979,13 @@ static void debug_show(const decNumber& decnum, const char* msg);
 
 // ----------------------------------------------------------------------------
 
-static void multics_decContext(decContext& context, flag_t scaled)
-{
-    decContextDefault(&context, DEC_INIT_BASE);
-    context.digits = 63;
-    int exp_digits = scaled ? 6 : 8;
-    context.emax = (2 << (exp_digits - 1)) - 1;
-    context.emin = - (2 << (exp_digits -1));
-    context.round = DEC_ROUND_HALF_UP;
-    context.clamp = 0;
-}
-
-
-// ----------------------------------------------------------------------------
-
-
-class dec_t {
-public:
-    // t_uint64 coe_val;
-    unsigned coe[65];       // original raw data, 0..9 or '0' .. '9'
-    // flag_t is_ascii;     // true if all the above are '0' .. '9'
-    char coe_text[65];      // '0' .. '9'
-    int width;              // width in bits of raw source data
-    int n_lz;               // number of leading zeros
-    int n_coe;
-    unsigned sign_nibble;   // original raw 4-bit or 9-bit sign byte
-    flag_t is_neg;          // sign byte intrepreted
-    flag_t is_zero; 
-    int exp;    // From floating point exponent or fixed point scale
-    dec_t() {}
-    dec_t(decNumber& decnum);
-};
+#include "dec_native.hpp"
 
 static int read_dec(num_desc_t& desc, dec_t& dec);
 static int write_decimal(const dec_t& src, num_desc_t desc2, flag_t rounding, flag_t trunc_fe);
 
 static int multics_to_dec(const dec_t& dec, decNumber& dnum);
-
+static int dv3d_to_decnum(const dec_t& n1, const dec_t& n2, decNumber** divisor_pp, decNumber** dividend_pp);
 // ============================================================================
 
 #if 1
@@ -1867,23 +2401,7 @@ static int write_decimal(const dec_t& src, num_desc_t desc2, flag_t rounding, fl
 
 // ============================================================================
 
-#if 1
-static int _op_dv3d(const instr_t* ip);
 int op_dv3d(const instr_t* ip)
-{
-    extern DEVICE cpu_dev;
-    int saved_debug = opt_debug;
-    int saved_dctrl = cpu_dev.dctrl;
-    ++ opt_debug; ++ cpu_dev.dctrl;
-    int ret = _op_dv3d(ip);
-    opt_debug = saved_debug;
-    cpu_dev.dctrl = saved_dctrl;
-    return ret;
-}
-#endif
-
-
-static int _op_dv3d(const instr_t* ip)
 {
     const char* moi = "OPU::dv3d";
 
@@ -1950,64 +2468,24 @@ static int _op_dv3d(const instr_t* ip)
     dec_t n2;
     if (read_dec(desc2, n2) != 0)
         ret = 1;
-
-    decNumber* divisor_p = new_decNumber();
-    decNumberZero(divisor_p);
-    decNumber* divisor_copy_p = new_decNumber();
-    if (multics_to_dec(n1, *divisor_p) != 0)
-        ret = 1;
-    memcpy(divisor_copy_p, divisor_p, sizeof(*divisor_p));
-    if (memcmp(divisor_copy_p, divisor_p, sizeof(*divisor_p)) != 0) {
-        log_msg(ERR_MSG, moi, "divisor damaged, line %d!!!\n", __LINE__);
-    }
-    debug_show(*divisor_p, "divisor");
-    if (memcmp(divisor_copy_p, divisor_p, sizeof(*divisor_p)) != 0) {
-        log_msg(ERR_MSG, moi, "divisor damaged, line %d!!!\n", __LINE__);
-    }
-    decNumber* dividend_p = new_decNumber();
-    decNumberZero(dividend_p);
-    if (multics_to_dec(n2, *dividend_p) != 0)
-        ret = 1;
-    if (memcmp(divisor_copy_p, divisor_p, sizeof(*divisor_p)) != 0) {
-        log_msg(ERR_MSG, moi, "divisor damaged, line %d!!!\n", __LINE__);
-        //char buf1[100];
-        //char buf2[100];
-        //decNumberToString(&divisor_copy, buf1);
-        //decNumberToString(&divisor, buf2);
-        //log_msg(ERR_MSG, moi, "divisor damaged, line %d; was '%s', now '%s'!!!\n", __LINE__, buf1, buf2);
-        debug_show(*divisor_copy_p, "divisor orig");
-        debug_show(*divisor_p, "divisor now");
-    }
-    debug_show(*dividend_p, "dividend");
-    if (memcmp(divisor_copy_p, divisor_p, sizeof(*divisor_p)) != 0) {
-        log_msg(ERR_MSG, moi, "divisor damaged, line %d!!!\n", __LINE__);
-    }
-    debug_show(*divisor_p, "divisor re-display");
     if (ret == 1) {
         fault_gen(illproc_fault);   // FIXME: somewhat bogus
         return 1;
     }
-    flush_logs();
-    {
-        char buf1[1000];    // must be 14 chars more than number of
-        char buf2[1000];    // coefficient digits
 
-        if (memcmp(divisor_copy_p, divisor_p, sizeof(*divisor_p)) != 0) {
-            log_msg(ERR_MSG, moi, "divisor damaged, line %d!!!\n", __LINE__);
-        }
-        decNumberToString(dividend_p, buf2);
-        log_msg(NOTIFY_MSG, moi, "DecNum dividend is '%s'.\n", buf2);
-        flush_logs();
-
-        if (memcmp(divisor_copy_p, divisor_p, sizeof(*divisor_p)) != 0) {
-            log_msg(ERR_MSG, moi, "divisor damaged, line %d!!!\n", __LINE__);
+#if FEAT_DEC_NATIVE
+    // Short operands skip decNumber entirely
+    int native = dec_native_ok(n1, 37) && dec_native_ok(n2, 38);
+#else
+    int native = 0;
+#endif
+    decNumber* divisor_p = NULL;
+    decNumber* dividend_p = NULL;
+    if (! native)
+        if (dv3d_to_decnum(n1, n2, &divisor_p, &dividend_p) != 0) {
+            fault_gen(illproc_fault);   // FIXME: somewhat bogus
+            return 1;
         }
-        decNumberToString(divisor_p, buf1);
-        log_msg(NOTIFY_MSG, moi, "DecNum divisor is '%s'.\n", buf1);
-        flush_logs();
-        // log_msg(NOTIFY_MSG, moi, "DecNum values are '%s' divided by '%s'.\n", buf2, buf1);
-    }
-    flush_logs();
 
     decContext context;
     multics_decContext(context, 0);
@@ -2015,13 +2493,21 @@ static int _op_dv3d(const instr_t* ip)
     int nq;
     if (desc3.s() == 0) {
         nq = desc3.n();
-        decNumber* cmp = new_decNumber();
-        decNumberZero(cmp);
-        decNumberCompare(cmp, divisor_p, dividend_p, &context);
-        int32 c = decNumberToInt32(cmp, &context);
+        int32 c;
+#if FEAT_DEC_NATIVE
+        if (native)
+            c = dec_compare_native(n1, n2);
+        else
+#endif
+        {
+            decNumber* cmp = new_decNumber();
+            decNumberZero(cmp);
+            decNumberCompare(cmp, divisor_p, dividend_p, &context);
+            c = decNumberToInt32(cmp, &context);
+            free(cmp);
+        }
         if (c == 1)
             --nq;
-        free(cmp);
     } else
         nq = (num_tot - n1.n_lz + 1)  - (divisor_tot - n2.n_lz) + (n2.exp - n1.exp - desc3.sf());
     if (round)
@@ -2036,20 +2522,37 @@ static int _op_dv3d(const instr_t* ip)
         return 1;
     }
 
-    decNumber* result_p = new_decNumber();
-    decNumberZero(result_p);
-    multics_decContext(context, 0); // FIXME: Should we adjust emax,emin by SF?
+    dec_t quot;
+#if FEAT_DEC_NATIVE
+    if (native && dec_divide_native(n2, n1, quot) == 0)
+        log_msg(DEBUG_MSG, moi, "Native divide gives %s%sE%d.\n", quot.is_neg ? "-" : "", quot.coe_text, quot.exp);
+    else
+#endif
     {
-        char buf1[100]; // must be 14 chars more than number of
-        char buf2[100]; // coefficient digits
-        decNumberToString(dividend_p, buf2);
-        decNumberToString(divisor_p, buf1);
-        log_msg(NOTIFY_MSG, moi, "Calling decnum divide for %s/%s.\n", buf2, buf1);
-        decNumberDivide(result_p, dividend_p, divisor_p, &context);
-        char buf3[100];
-        decNumberToString(result_p, buf3);
-        log_msg(NOTIFY_MSG, moi, "Result of %s/%s is %s.\n", buf2, buf1, buf3);
+        if (divisor_p == NULL)
+            if (dv3d_to_decnum(n1, n2, &divisor_p, &dividend_p) != 0) {
+                fault_gen(illproc_fault);   // FIXME: somewhat bogus
+                return 1;
+            }
+        decNumber* result_p = new_decNumber();
+        decNumberZero(result_p);
+        multics_decContext(context, 0); // FIXME: Should we adjust emax,emin by SF?
+        {
+            char buf1[100]; // must be 14 chars more than number of
+            char buf2[100]; // coefficient digits
+            decNumberToString(dividend_p, buf2);
+            decNumberToString(divisor_p, buf1);
+            log_msg(NOTIFY_MSG, moi, "Calling decnum divide for %s/%s.\n", buf2, buf1);
+            decNumberDivide(result_p, dividend_p, divisor_p, &context);
+            char buf3[100];
+            decNumberToString(result_p, buf3);
+            log_msg(NOTIFY_MSG, moi, "Result of %s/%s is %s.\n", buf2, buf1, buf3);
+        }
+        quot = dec_t(*result_p);
+        free(result_p);
     }
+    free(divisor_p);
+    free(dividend_p);
 
 
     // FIXME -- check if write_decimal constraints match dv3d as well as mvn
@@ -2073,7 +2576,6 @@ example result format: 3 digits an scale of 2 --- ??? x 10^2
     -- add char range tests to dividend/divisor reads & illproc
 #endif
 
-    dec_t quot(*result_p);
     if (write_decimal(quot, desc3, round, trunc) != 0)
         return 1;
 
@@ -2084,15 +2586,53 @@ example result format: 3 digits an scale of 2 --- ??? x 10^2
     log_msg(ERR_MSG, moi, "Lightly tested; auto breakpoint\n");
     cancel_run(STOP_IBKPT);
 
-    free(divisor_p);
-    free(divisor_copy_p);
-    free(dividend_p);
-    free(result_p);
-
     PPR.IC += 4;
     return 1;
 }
 
+// ----------------------------------------------------------------------------
+
+/*
+ * dv3d_to_decnum()
+ *
+ * Convert the divisor and dividend of dv3d to newly allocated decNumbers.
+ */
+
+static int dv3d_to_decnum(const dec_t& n1, const dec_t& n2, decNumber** divisor_pp, decNumber** dividend_pp)
+{
+    const char* moi = "OPU::dv3d";
+
+    int ret = 0;
+    decNumber* divisor_p = new_decNumber();
+    decNumberZero(divisor_p);
+    decNumber* divisor_copy_p = new_decNumber();
+    if (multics_to_dec(n1, *divisor_p) != 0)
+        ret = 1;
+    memcpy(divisor_copy_p, divisor_p, sizeof(*divisor_p));
+    debug_show(*divisor_p, "divisor");
+    decNumber* dividend_p = new_decNumber();
+    decNumberZero(dividend_p);
+    if (multics_to_dec(n2, *dividend_p) != 0)
+        ret = 1;
+    if (memcmp(divisor_copy_p, divisor_p, sizeof(*divisor_p)) != 0) {
+        log_msg(ERR_MSG, moi, "divisor damaged, line %d!!!\n", __LINE__);
+        debug_show(*divisor_copy_p, "divisor orig");
+        debug_show(*divisor_p, "divisor now");
+    }
+    free(divisor_copy_p);
+    debug_show(*dividend_p, "dividend");
+    if (opt_debug) {
+        char buf1[1000];    // must be 14 chars more than number of
+        char buf2[1000];    // coefficient digits
+        decNumberToString(dividend_p, buf2);
+        decNumberToString(divisor_p, buf1);
+        log_msg(DEBUG_MSG, moi, "DecNum values are '%s' divided by '%s'.\n", buf2, buf1);
+    }
+    *divisor_pp = divisor_p;
+    *dividend_pp = dividend_p;
+    return ret;
+}
+
 // ============================================================================
 
 /*
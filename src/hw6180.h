@@ -23,6 +23,7 @@ extern "C" {
 extern t_addr (*sim_vm_parse_addr)(DEVICE *, char *, char **);
 extern void (*sim_vm_fprint_addr)(FILE *, DEVICE *, t_addr);
 extern uint32 sim_brk_types, sim_brk_dflt, sim_brk_summ; /* breakpoint info */
+extern BRKTAB *sim_brk_fnd(t_addr loc);
 
 /* Additions to SIMH -- may conflict with future versions of SIMH */
 #define REG_USER1 040000000
@@ -629,6 +630,9 @@ typedef struct {
         int xfer;
     } mt_times;
     flag_t warn_uninit; // Warn when reading uninitialized memory
+    flag_t block_cache;
+        // Execute hot code from the block cache rather than via the
+        // FETCH and EXEC cycles.  See "set cpu blockcache" and FEAT_BLOCK_CACHE.
     flag_t startup_interrupt;
         // The CPU is supposed to start with a startup fault.  This will cause
         // a series of trouble faults until the IOM finally writes a DIS from
@@ -660,8 +664,21 @@ typedef struct {
 // Memory.
 // Most access is via fetch_abs_word() and store_abs_word(), but a
 // few source files make direct access (debugging and the IOM).
+// With FEAT_MEM_CHECK_UNINIT, code storing directly into Mem[] should
+// use MEM_MARK_WRITTEN() so reads of the word don't draw warnings.
 #define MAXMEMSIZE (16*1024*1024)
 extern t_uint64 *Mem;
+extern uint32 *Mem_written;     // one bit per word of Mem[]; see FEAT_MEM_CHECK_UNINIT
+#define MEM_MARK_WRITTEN(addr) (Mem_written[(addr) >> 5] |= (uint32) 1 << ((addr) & 31))
+#define MEM_IS_WRITTEN(addr) ((Mem_written[(addr) >> 5] >> ((addr) & 31)) & 1)
+
+// Attributes of absolute memory pages.  Pages with attributes take the slow
+// paths of fetch_abs_word() and store_abs_word(); see mem_region_add().
+#define MEM_ATTR_TRACE  001     // accesses logged when debugging (mailboxes, etc)
+#define MEM_ATTR_WATCH  002     // accesses always logged; see the xwatch command
+#define MEM_ATTR_CODE   004     // holds predecoded or cached instructions
+#define MEM_ATTR_BRK    010     // might hold an absolute mode breakpoint
+#define MEM_ATTR_UNINIT 020     // might hold words never written
 
 // Non CPU
 extern int opt_debug;
@@ -715,6 +732,7 @@ extern int scan_seg(uint segno, int msgs);  // scan definitions section for proc
 
 /* debug_run.cpp */
 extern void check_seg_debug(void);
+extern int seg_debug_any(void);
 extern void state_invalidate_cache(void);
 extern void state_save(void);
 extern void state_dump_changes(void);
@@ -751,6 +769,15 @@ extern int fetch_word(uint addr, t_uint64 *wordp);
 extern int fetch_abs_word(uint addr, t_uint64 *wordp);
 extern int store_word(uint addr, t_uint64 word);
 extern int store_abs_word(uint addr, t_uint64 word);
+extern int mem_direct_ok(uint lo, uint hi);
+extern void mem_stored(uint lo, uint hi);
+extern void unpack72(const unsigned char *bufp, uint npairs, t_uint64 *wordsp);
+extern void unpack_words(const unsigned char *bufp, t_uint64 first, uint n, t_uint64 *wordsp);
+extern void pack_words(const t_uint64 *wordsp, uint n, unsigned char *bufp, t_uint64 first);
+extern void mem_attr_init(void);
+extern int mem_region_add(uint lo, uint hi, uint8 attr, const char *name);
+extern int mem_region_del(uint lo, uint8 attr);
+extern int cmd_watch(int32 arg, char *buf);
 extern int store_abs_pair(uint addr, t_uint64 word0, t_uint64 word1);
 extern int store_pair(uint addr, t_uint64 word0, t_uint64 word1);
 extern int fetch_abs_pair(uint addr, t_uint64* word0p, t_uint64* word1p);
@@ -762,11 +789,15 @@ extern int store_yblock16(uint addr, const t_uint64 *wordsp);
 extern void word2instr(t_uint64 word, instr_t *ip);
 extern void decode_instr(t_uint64 word);
 extern void encode_instr(const instr_t *ip, t_uint64 *wordp);
+extern void cpu_block_flush(void);
+extern int brk_page_flagged(addr_modes_t mode, uint segno, uint offset);
 extern char *bin2text(t_uint64 word, int n);
 
 /* opu.c */
 extern void execute_instr(void);
 extern void cu_safe_store(void);
+extern void opu_init_dispatch(void);
+extern int opu_is_eis_multiword(uint opcode);
 extern int add72(t_uint64 ahi, t_uint64 alow, t_uint64* dest1, t_uint64* dest2, int is_unsigned);
 
 /* eis_opu.cpp */
@@ -775,7 +806,8 @@ extern int op_tct(const instr_t* ip, int fwd);
 extern int op_mvt(const instr_t* ip);
 extern int op_cmpc(const instr_t* ip);
 extern int op_cmpb(const instr_t* ip);
-extern int op_csl(const instr_t* ip);
+extern int op_csl(const instr_t* ip, int fwd);
+extern int op_sztl(const instr_t* ip, int fwd);
 extern int op_btd(const instr_t* ip);
 extern int op_dtb(const instr_t* ip);
 extern int op_scm(const instr_t* ip, int fwd);
@@ -810,12 +842,15 @@ extern int addr_mod(void);
 extern void reg_mod(uint td, int off);          // FIXME: might be performance boost if inlined
 extern int fetch_appended(uint addr, t_uint64 *wordp);
 extern int store_appended(uint offset, t_uint64 word);
+extern int fetch_appended_block(uint offset, uint n, t_uint64 *wordsp);
+extern int store_appended_block(uint offset, uint n, const t_uint64 *wordsp);
 extern int cmd_dump_vm(int32 arg, char *buf);
 extern int apu_show_vm(FILE *st, UNIT *uptr, int val, void *desc);
 extern SDW_t* get_sdw();
 extern int addr_any_to_abs(uint *addrp, addr_modes_t mode, int segno, int offset);
 extern int convert_address(uint* addrp, int seg, int offset, int fault);
 extern int get_seg_addr(uint offset, uint perm_mode, uint *addrp);
+extern void apu_tlb_flush(void);
 extern char* print_ptw(t_uint64 word);
 extern char* print_sdw(t_uint64 word0, t_uint64 word1);
 extern char* sdw2text(const SDW_t *sdwp);
@@ -861,11 +896,13 @@ extern int addr_mod_eis_addr_reg(instr_t *ip);
 extern void mt_init(void);
 extern int mt_iom_cmd(chan_devinfo* devinfop);
 extern int mt_iom_io(chan_devinfo* devinfop, t_uint64 *wordp);
+extern int mt_iom_io_block(chan_devinfo* devinfop, t_uint64 *wordsp, uint n, uint *countp);
 
 /* disk.c */
 extern void disk_init(void);
 extern int disk_iom_cmd(chan_devinfo* devinfop);
-extern int disk_iom_io(int chan, t_uint64 *wordp, int* majorp, int* subp);
+extern int disk_iom_io(chan_devinfo* devinfop, t_uint64 *wordp);
+extern int disk_iom_io_block(chan_devinfo* devinfop, t_uint64 *wordsp, uint n, uint *countp);
 
 /* console.c */
 extern void console_init(void);
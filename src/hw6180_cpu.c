@@ -38,6 +38,7 @@
 #include <fcntl.h>
 
 #include "hw6180.h"
+#include "seginfo.hpp"
 #include "sim_tape.h"
 // #include "bits.h"
 
@@ -53,6 +54,7 @@ extern int32 sim_switches;
 // *** Main memory
 
 t_uint64 *Mem;
+uint32 *Mem_written;
 
 //-----------------------------------------------------------------------------
 // *** CPU Registers
@@ -221,6 +223,8 @@ extern int iom_show_mbx(FILE *st, UNIT *uptr, int val, void *desc); // FIXME
 static int cpu_set_fault_base(UNIT *uptr, int32 val, char *cptr, void *desc);
 static int cpu_show_fault_base(FILE *st, UNIT *uptr, int32 val, void *desc);
 static int cpu_set_model(UNIT *uptr, int32 val, char *cptr, void *desc);
+static int cpu_set_block_cache(UNIT *uptr, int32 val, char *cptr, void *desc);
+static int cpu_show_block_cache(FILE *st, UNIT *uptr, int32 val, void *desc);
 static int cpu_show_model(FILE *st, UNIT *uptr, int32 val, void *desc);
 static MTAB cpu_mod[] = {
     // for SIMH "show" and "set" commands
@@ -242,6 +246,12 @@ static MTAB cpu_mod[] = {
     { MTAB_XTD | MTAB_VDV | MTAB_NC,
       0, "FAULT_BASE", "FAULT_BASE",
       cpu_set_fault_base, cpu_show_fault_base, NULL },
+    { MTAB_XTD | MTAB_VDV | MTAB_NC,
+      1, "BLOCKCACHE", "BLOCKCACHE",
+      cpu_set_block_cache, cpu_show_block_cache, NULL },
+    { MTAB_XTD | MTAB_VDV | MTAB_NC,
+      0, NULL, "NOBLOCKCACHE",
+      cpu_set_block_cache, NULL, NULL },
     { 0 }
 };
 
@@ -268,6 +278,8 @@ extern t_stat clk_svc(UNIT *up);
 UNIT TR_clk_unit = { UDATA(&clk_svc, UNIT_IDLE, 0) };
 
 extern t_stat mt_svc(UNIT *up);
+extern t_stat mt_attach(UNIT *uptr, char *cptr);
+extern t_stat mt_detach(UNIT *uptr);
 UNIT mt_unit = {
     // NOTE: other SIMH tape sims don't set UNIT_SEQ
     UDATA (&mt_svc, UNIT_ATTABLE | UNIT_SEQ | UNIT_ROABLE | UNIT_DISABLE | UNIT_IDLE, 0)
@@ -277,7 +289,7 @@ DEVICE tape_dev = {
     "TAPE", &mt_unit, NULL, NULL, 1,
     10, 31, 1, 8, 9,
     NULL, NULL, NULL,
-    NULL, &sim_tape_attach, &sim_tape_detach,
+    NULL, &mt_attach, &mt_detach,
     NULL, DEV_DEBUG
 };
 
@@ -296,6 +308,8 @@ DEVICE tape_dev = {
 //  3530555392 bytes, 98070983 records?
 
 // extern t_stat disk_svc(UNIT *up);
+extern t_stat disk_attach(UNIT *uptr, char *cptr);
+extern t_stat disk_detach(UNIT *uptr);
 UNIT disk_unit = {
     UDATA (&channel_svc, UNIT_FIX | UNIT_ATTABLE | UNIT_ROABLE | UNIT_DISABLE | UNIT_IDLE, M3381_SECTORS)
 };
@@ -306,7 +320,7 @@ DEVICE disk_dev = {
     10, 24, 1, 8, 36,
     /* examine */ NULL, /* deposit */ NULL,
     /* reset */ NULL, /* boot */ NULL,
-    /* attach */ NULL, /* detach */ NULL,
+    /* attach */ &disk_attach, /* detach */ &disk_detach,
     /* context */ NULL, DEV_DEBUG
 };
 
@@ -410,6 +424,101 @@ static int fault2prio[32] = {
 
 static int is_eis[1024];    // hack
 
+// Predecoded instruction cache.  Direct mapped and indexed by the absolute
+// address of the instruction word.  Saves re-running word2instr() each time
+// tight loops re-fetch the same words.  An entry is dropped whenever its
+// word is written via store_abs_word(); all other CPU and IOM stores
+// (store_abs_pair(), store_yblock*(), IOM data DCWs, etc) go through that
+// routine.  Code that writes Mem[] directly must call predecode_flush().
+#define PREDECODE_BITS 13
+typedef struct {
+    uint tag;           // absolute address plus one; zero for an empty slot
+    instr_t instr;
+} predecode_t;
+static predecode_t predecode[1 << PREDECODE_BITS];
+
+#if FEAT_BLOCK_CACHE
+// Basic-block cache.  A block is a run of pre-decoded instructions starting
+// at a given PPR.PSR|IC and ending before the first XEC, XED, RPT, RPD, RPL,
+// RCU, DIS, or EIS multiword instruction.  Blocks never cross a 16 word
+// boundary; segment bounds have that granularity, so any block entered via
+// a successful instruction fetch stays in bounds.  Blocks are only built
+// after such a fetch and are discarded whenever the translation state
+// changes (ldbr, cams, camp) or a word within a cached block is stored.
+// Discarding is done by bumping block_gen.
+#define BLOCK_BITS 11
+#define BLOCK_MAX 16
+#define BLOCK_HOT 8     // fetches of an entry point before a block is built
+typedef struct block_s {
+    uint gen;           // block_gen when built; zero for an empty slot
+    uint ic;            // Tag: entry IC, segment, ring, and address mode
+    uint psr;
+    uint prr;
+    addr_modes_t mode;
+    uint abs;           // absolute address of the entry instruction
+    uint n;             // number of instructions
+    struct block_s *succ[2];    // last successor seen: fall through, transfer
+    instr_t instr[BLOCK_MAX];
+} block_t;
+static block_t blocks[1 << BLOCK_BITS];
+static uint block_gen = 1;
+static uint8 block_code_map[MAXMEMSIZE / BLOCK_MAX / 8];    // 16 word groups holding cached blocks
+static uint8 block_stop[1024];  // opcodes that must not be part of a block
+static uint8 block_heat[1 << BLOCK_BITS];   // per-slot hotness counters
+static int block_exec_ok;       // production loop is running; blocks allowed
+static struct {
+    t_uint64 built;     // blocks built
+    t_uint64 entered;   // blocks entered, including via chaining
+    t_uint64 chained;   // blocks entered via a cached successor pointer
+    t_uint64 ninstr;    // instructions executed from blocks
+    t_uint64 flushes;
+} block_stats;
+#endif
+
+#if FEAT_REPEAT_LOOP
+static int repeat_exec_ok;      // production loop is running; repeat loops may skip the CU cycles
+#endif
+
+// Breakpoint index.  SIMH only gives us sim_brk_test(), which wants a
+// packed address and does a table search, so testing every memory
+// reference gets expensive once any breakpoint is set.  Instead we keep
+// one "known" and one "flagged" bit per absolute page and per (segno,
+// page).  A page is classified on first reference by asking SIMH about
+// each of its words.  Breakpoints can only be changed at the SIMH prompt,
+// so the index is discarded on every entry to sim_instr() and is not used
+// at all while at the prompt.
+
+#define BRK_PAGE_BITS 10
+#define BRK_SEG_PAGES (1 << (15 + 18 - BRK_PAGE_BITS))
+
+static uint32 brk_abs_known[MAXMEMSIZE >> BRK_PAGE_BITS >> 5];
+static uint32 brk_abs_flagged[MAXMEMSIZE >> BRK_PAGE_BITS >> 5];
+static uint32 brk_seg_known[BRK_SEG_PAGES >> 5];
+static uint32 brk_seg_flagged[BRK_SEG_PAGES >> 5];
+static int brk_index_valid;
+
+// Memory attribute map.  One byte of MEM_ATTR_* bits per absolute page
+// tells fetch_abs_word() and store_abs_word() whether an access needs more
+// than a plain load or store.  Pages are the same size as those of the
+// breakpoint index, so a BRK bit maps onto one breakpoint index bit.  The
+// BRK bit means "might hold a breakpoint"; it is cleared once the
+// breakpoint index says otherwise.  TRACE and WATCH come from the list of
+// regions maintained by mem_region_add().
+
+#define MEM_ATTR_PAGE_BITS BRK_PAGE_BITS
+#define MEM_ATTR_FETCH_SLOW (MEM_ATTR_TRACE | MEM_ATTR_WATCH | MEM_ATTR_BRK | MEM_ATTR_UNINIT)
+#define MEM_ATTR_STORE_SLOW (MEM_ATTR_TRACE | MEM_ATTR_WATCH | MEM_ATTR_BRK | MEM_ATTR_UNINIT | MEM_ATTR_CODE)
+#define MEM_REGIONS_MAX 32
+
+static uint8 mem_attr[MAXMEMSIZE >> MEM_ATTR_PAGE_BITS];
+typedef struct {
+    uint lo, hi;        // absolute addresses, inclusive
+    uint8 attr;         // MEM_ATTR_TRACE or MEM_ATTR_WATCH
+    char name[24];
+} mem_region_t;
+static mem_region_t mem_regions[MEM_REGIONS_MAX];
+static int mem_nregions;
+
 //-----------------------------------------------------------------------------
 // ***  Function prototypes
 
@@ -419,14 +528,38 @@ static t_stat control_unit(void);
 static void execute_ir(void);
 static void init_opcodes(void);
 static void check_events(void);
+static void dis_idle(void);
+static int store_yblock(uint addr, int aligned, int n, const t_uint64 *wordsp);
+static void repeat_tally(flag_t do_odd);
+#if FEAT_REPEAT_LOOP
+static int repeat_loop(void);
+#endif
+static void brk_index_reset(void);
+static void mem_attr_refresh(void);
+static void mem_attr_set_all(uint8 attr);
+static int mem_attr_brk(uint page);
+static void mem_attr_check_written(uint page);
+static void mem_region_log(const char *what, uint addr, t_uint64 word, uint8 attr);
+static void fetch_abs_slow(uint addr, t_uint64 *wordp);
+static void store_abs_slow(uint addr, t_uint64 word);
 static void save_to_simh(void);
 static void save_PR_registers(void);
 static void restore_PR_registers(void);
-static int write72(FILE* fp, t_uint64 word0, t_uint64 word1);
-static int read72(FILE* fp, t_uint64* word0p, t_uint64* word1p);
+#if FEAT_BLOCK_CACHE
+static block_t* block_lookup(void);
+static void block_build(uint abs);
+static int block_run(block_t* bp);
+#endif
+static void pack72(const t_uint64 *wordsp, uint npairs, unsigned char *bufp);
+static t_stat load_dense(FILE *fileref, const char *fnam, const unsigned char *head, uint nhead);
+static t_stat load_sparse(FILE *fileref, const char *fnam);
+static t_stat dump_sparse(FILE *fileref, const char *fnam);
 static void set_IR_bitnames(uint32 irval);
 void init_memory_iom();
 static t_uint64 save_TPR(const TPR_t *tprp);
+static void predecode_flush(void);
+static void decode_instr_abs(t_uint64 word, uint addr);
+static void decode_setup(void);
 
 //=============================================================================
 
@@ -587,6 +720,34 @@ t_stat cpu_reset (DEVICE *dptr)
 
 //=============================================================================
 
+/*
+ * Sparse memory dumps.
+ *
+ * The SIMH "dump" command writes memory in this format.  The "load"
+ * command accepts it as well as the dense format of load_dense().  All
+ * numbers are 32-bit big-endian.
+ *
+ *      magic           MEMDUMP_MAGIC
+ *      page_words      words per page (1 << MEM_ATTR_PAGE_BITS)
+ *      npages          number of directory entries
+ *      directory       npages entries, ascending: a page number, plus
+ *                      MEMDUMP_ZERO if the page was written but is all zero
+ *      data            for each entry without MEMDUMP_ZERO, the page
+ *                      as packed 72-bit pairs
+ *
+ * Pages that are all zero and were never written are left out entirely.
+ * A load does not touch those pages unless they currently hold data, so
+ * the host never commits memory for them.
+ */
+
+#define MEMDUMP_MAGIC "HW6180M1"
+#define MEMDUMP_MAGIC_LEN 8
+#define MEMDUMP_ZERO 0x80000000
+#define MEMDUMP_PAGE_WORDS (1 << MEM_ATTR_PAGE_BITS)
+#define MEMDUMP_PAGE_BYTES (MEMDUMP_PAGE_WORDS / 2 * 9)
+
+//=============================================================================
+
 /*
  * sim_load()
  *
@@ -606,34 +767,245 @@ t_stat cpu_reset (DEVICE *dptr)
 
 t_stat sim_load (FILE *fileref, char *cptr, char *fnam, int32 write_flag)
 {
-    // Assumes that MAXMEMSIZE is an even number...
     if (write_flag) {
         out_msg("Dumping memory to %s.\n", fnam);
-        for (int i = 0; i < MAXMEMSIZE - 1; i += 2) {
-            if (write72(fileref, Mem[i], Mem[i+1]) != 0) {
-                log_msg(ERR_MSG, "DUMP", "Error writing %s: %s\n", fnam, strerror(errno));
-                return SCPE_IOERR;
-            }
-        }
+        t_stat ret = dump_sparse(fileref, fnam);
+        if (ret != SCPE_OK)
+            return ret;
     } else {
         out_msg("Loading memory from %s.\n", fnam);
-        for (int i = 0; i < MAXMEMSIZE - 1; i += 2) {
-            if (feof(fileref)) {
-                out_msg("EOF on %s after %d words\n", fnam, i);
-                bootimage_loaded = 1;
-                return SCPE_OK;
-            }
-            if (read72(fileref, &Mem[i], &Mem[i+1]) != 0) {
-                log_msg(ERR_MSG, "DUMP", "Error reading %s: %s\n", fnam, strerror(errno));
+        predecode_flush();
+        unsigned char head[MEMDUMP_MAGIC_LEN];
+        uint nhead = fread(head, 1, sizeof(head), fileref);
+        t_stat ret;
+        if (nhead == sizeof(head) && memcmp(head, MEMDUMP_MAGIC, sizeof(head)) == 0)
+            ret = load_sparse(fileref, fnam);
+        else
+            ret = load_dense(fileref, fnam, head, nhead);
+        if (ret != SCPE_OK)
+            return ret;
+        bootimage_loaded = 1;
+    }
+    out_msg("Done.\n");
+    return SCPE_OK;
+}
+
+//=============================================================================
+
+/*
+ * load_dense()
+ *
+ * Load an image of memory from address zero up, as packed 72-bit pairs.
+ * This was the only format before the sparse one, and it is still what
+ * most boot images use.  A short file loads only the low part of memory.
+ * The caller has already read the first nhead bytes of the file into head.
+ */
+
+static t_stat load_dense(FILE *fileref, const char *fnam, const unsigned char *head, uint nhead)
+{
+    enum { chunk_pairs = 16384 };
+    unsigned char *buf = malloc(chunk_pairs * 9);
+    if (buf == NULL) {
+        log_msg(ERR_MSG, "LOAD", "Cannot allocate buffer.\n");
+        return SCPE_MEM;
+    }
+    memcpy(buf, head, nhead);
+    uint have = nhead;      // bytes in buf
+    uint addr = 0;
+    while (addr < MAXMEMSIZE) {
+        uint want = chunk_pairs * 9;
+        if (want > (MAXMEMSIZE - addr) / 2 * 9)
+            want = (MAXMEMSIZE - addr) / 2 * 9;
+        have += fread(buf + have, 1, want - have, fileref);
+        if (ferror(fileref)) {
+            log_msg(ERR_MSG, "LOAD", "Error reading %s: %s\n", fnam, strerror(errno));
+            free(buf);
+            return SCPE_IOERR;
+        }
+        uint npairs = have / 9;
+        unpack72(buf, npairs, &Mem[addr]);
+        if (npairs != 0)
+            mem_stored(addr, addr + 2 * npairs - 1);
+        addr += 2 * npairs;
+        if (have < want) {
+            free(buf);
+            if (have % 9 != 0) {
+                log_msg(ERR_MSG, "LOAD", "%s ends in the middle of a word pair.\n", fnam);
                 return SCPE_IOERR;
             }
+            out_msg("EOF on %s after %d words\n", fnam, addr);
+            return SCPE_OK;
         }
-        bootimage_loaded = 1;
+        have = 0;
     }
-    out_msg("Done.\n");
+    free(buf);
+    return SCPE_OK;
+}
+
+//=============================================================================
+
+static void put32(unsigned char *p, uint32 v)
+{
+    p[0] = v >> 24;
+    p[1] = v >> 16;
+    p[2] = v >> 8;
+    p[3] = v;
+}
+
+static uint32 get32(const unsigned char *p)
+{
+    return ((uint32) p[0] << 24) | ((uint32) p[1] << 16) | ((uint32) p[2] << 8) | p[3];
+}
+
+//=============================================================================
+
+/*
+ * mem_page_state()
+ *
+ * Returns 0 for a page that is all zero and was never written,
+ * MEMDUMP_ZERO for any other all-zero page, and 1 for a page that holds
+ * data.
+ */
+
+static uint32 mem_page_state(uint page)
+{
+    uint lo = page * MEMDUMP_PAGE_WORDS;
+    int written = 0;
+#if FEAT_MEM_CHECK_UNINIT
+    for (uint i = 0; i < MEMDUMP_PAGE_WORDS / 32; ++i)
+        written |= Mem_written[lo / 32 + i] != 0;
+    if (! written)
+        return 0;
+#endif
+    t_uint64 any = 0;
+    for (uint i = 0; i < MEMDUMP_PAGE_WORDS; ++i)
+        any |= Mem[lo + i];
+    if (any != 0)
+        return 1;
+    return (written) ? MEMDUMP_ZERO : 0;
+}
+
+//=============================================================================
+
+static t_stat dump_sparse(FILE *fileref, const char *fnam)
+{
+    const uint maxpages = MAXMEMSIZE / MEMDUMP_PAGE_WORDS;
+    unsigned char *dir = malloc(maxpages * 4);
+    unsigned char *buf = malloc(MEMDUMP_PAGE_BYTES);
+    if (dir == NULL || buf == NULL) {
+        free(dir);
+        free(buf);
+        log_msg(ERR_MSG, "DUMP", "Cannot allocate buffers.\n");
+        return SCPE_MEM;
+    }
+
+    uint npages = 0, ndata = 0;
+    for (uint page = 0; page < maxpages; ++page) {
+        uint32 state = mem_page_state(page);
+        if (state == 0)
+            continue;
+        put32(dir + 4 * npages++, page | (state & MEMDUMP_ZERO));
+        if (state == 1)
+            ++ ndata;
+    }
+
+    unsigned char head[MEMDUMP_MAGIC_LEN + 8];
+    memcpy(head, MEMDUMP_MAGIC, MEMDUMP_MAGIC_LEN);
+    put32(head + MEMDUMP_MAGIC_LEN, MEMDUMP_PAGE_WORDS);
+    put32(head + MEMDUMP_MAGIC_LEN + 4, npages);
+    int err = fwrite(head, 1, sizeof(head), fileref) != sizeof(head)
+        || fwrite(dir, 4, npages, fileref) != npages;
+    for (uint i = 0; ! err && i < npages; ++i) {
+        uint32 entry = get32(dir + 4 * i);
+        if (entry & MEMDUMP_ZERO)
+            continue;
+        pack72(&Mem[entry * MEMDUMP_PAGE_WORDS], MEMDUMP_PAGE_WORDS / 2, buf);
+        err = fwrite(buf, 1, MEMDUMP_PAGE_BYTES, fileref) != MEMDUMP_PAGE_BYTES;
+    }
+    free(dir);
+    free(buf);
+    if (err) {
+        log_msg(ERR_MSG, "DUMP", "Error writing %s: %s\n", fnam, strerror(errno));
+        return SCPE_IOERR;
+    }
+    out_msg("Wrote %u of %u pages (%u all zero).\n", npages, maxpages, npages - ndata);
     return SCPE_OK;
 }
 
+//=============================================================================
+
+static t_stat load_sparse(FILE *fileref, const char *fnam)
+{
+    const uint maxpages = MAXMEMSIZE / MEMDUMP_PAGE_WORDS;
+    unsigned char head[8];
+    if (fread(head, 1, sizeof(head), fileref) != sizeof(head)) {
+        log_msg(ERR_MSG, "LOAD", "Error reading header of %s.\n", fnam);
+        return SCPE_IOERR;
+    }
+    uint32 page_words = get32(head);
+    uint32 npages = get32(head + 4);
+    if (page_words != MEMDUMP_PAGE_WORDS || npages > maxpages) {
+        log_msg(ERR_MSG, "LOAD", "%s has %u pages of %u words; expecting at most %u pages of %u words.\n",
+            fnam, npages, page_words, maxpages, MEMDUMP_PAGE_WORDS);
+        return SCPE_IOERR;
+    }
+
+    unsigned char *dir = malloc(npages * 4 + 1);
+    unsigned char *buf = malloc(MEMDUMP_PAGE_BYTES);
+    if (dir == NULL || buf == NULL) {
+        free(dir);
+        free(buf);
+        log_msg(ERR_MSG, "LOAD", "Cannot allocate buffers.\n");
+        return SCPE_MEM;
+    }
+    if (fread(dir, 4, npages, fileref) != npages) {
+        log_msg(ERR_MSG, "LOAD", "Error reading directory of %s.\n", fnam);
+        free(dir);
+        free(buf);
+        return SCPE_IOERR;
+    }
+
+    t_stat ret = SCPE_OK;
+    uint next = 0;      // lowest page not yet handled
+    for (uint i = 0; i <= npages; ++i) {
+        uint32 entry = (i < npages) ? get32(dir + 4 * i) : maxpages;
+        uint page = entry & ~ MEMDUMP_ZERO;
+        if (page < next || page > maxpages || (page == maxpages && i < npages)) {
+            log_msg(ERR_MSG, "LOAD", "Bad directory entry %u in %s.\n", i, fnam);
+            ret = SCPE_IOERR;
+            break;
+        }
+        // Pages missing from the directory were never written
+        for (; next < page; ++next)
+            if (mem_page_state(next) != 0) {
+                uint lo = next * MEMDUMP_PAGE_WORDS;
+                memset(&Mem[lo], 0, MEMDUMP_PAGE_WORDS * sizeof(*Mem));
+#if FEAT_MEM_CHECK_UNINIT
+                memset(&Mem_written[lo / 32], 0, MEMDUMP_PAGE_WORDS / 8);
+                mem_attr[next] |= MEM_ATTR_UNINIT;
+#endif
+            }
+        if (i == npages)
+            break;
+        uint lo = page * MEMDUMP_PAGE_WORDS;
+        if (entry & MEMDUMP_ZERO)
+            memset(&Mem[lo], 0, MEMDUMP_PAGE_WORDS * sizeof(*Mem));
+        else if (fread(buf, 1, MEMDUMP_PAGE_BYTES, fileref) == MEMDUMP_PAGE_BYTES)
+            unpack72(buf, MEMDUMP_PAGE_WORDS / 2, &Mem[lo]);
+        else {
+            log_msg(ERR_MSG, "LOAD", "Error reading page %#o of %s.\n", page, fnam);
+            ret = SCPE_IOERR;
+            break;
+        }
+        mem_stored(lo, lo + MEMDUMP_PAGE_WORDS - 1);
+        next = page + 1;
+    }
+    free(dir);
+    free(buf);
+    if (ret == SCPE_OK)
+        out_msg("Loaded %u pages.\n", npages);
+    return ret;
+}
 
 //=============================================================================
 
@@ -668,6 +1040,7 @@ void init_memory_iom()
     // " MPC itself.
 
     log_msg(INFO_MSG, "CPU::IOM", "Performing load of eleven words from IOM bootchanel to memory.\n");
+    predecode_flush();  // we write directly to Mem[] below
 
     const int base = iom.base;      // 12 bits; IOM base; switch values
     // bootload_io.alm insists that pi_base match
@@ -749,10 +1122,16 @@ void init_memory_iom()
 
     for (unsigned i = 0; i < ARRAY_SIZE(locs); ++i) {
         int addr = locs[i];
+#if FEAT_MEM_CHECK_UNINIT
+        MEM_MARK_WRITTEN(addr);
+#endif
         log_msg(NOTIFY_MSG, "IOM::boot", "Mem[%08o]: %012llo\n",
             addr, Mem[addr]);
         }
     }
+#if FEAT_MEM_CHECK_UNINIT
+    MEM_MARK_WRITTEN(010 + 2 * iom_num + 1);
+#endif
 }
 
 //=============================================================================
@@ -890,6 +1269,12 @@ t_stat sim_instr(void)
     // opt_debug = (cpu_dev.dctrl != 0);    // todo: should CPU control all debug settings?
 
     state_invalidate_cache();   // todo: only need to do when changing debug settings
+#if FEAT_BLOCK_CACHE
+    cpu_block_flush();          // registers may have been changed from the SIMH prompt
+#endif
+    apu_tlb_flush();            // ditto for the DSBR and the SDWAM/PTWAM
+    brk_index_reset();          // and breakpoints
+    mem_attr_refresh();
 
     // Setup clocks
     (void) sim_rtcn_init(CLK_TR_HZ, TR_CLK);
@@ -908,6 +1293,55 @@ t_stat sim_instr(void)
         sim_interval = 32;
     }
 
+    // Production loop.  When nobody is watching -- no debugging, no source
+    // listings, and no per-segment xdebug overrides -- we skip the
+    // per-cycle source tracking and state dumping done by the instrumented
+    // loop below.  Breakpoints are still honored by control_unit() and the
+    // memory access routines, but cached blocks are not used because they
+    // bypass the execution breakpoint test.  These settings only change at the SIMH
+    // prompt, so we decide once per call.  However, some instructions turn
+    // on debugging as a side effect, so we drop into the instrumented
+    // loop if that happens.
+    if (reason == 0 && ! opt_debug && ! seg_debug_any() && ! seginfo_have_source()) {
+#if FEAT_BLOCK_CACHE
+        block_exec_ok = sys_opts.block_cache && ! sim_brk_summ;
+#endif
+#if FEAT_REPEAT_LOOP
+        repeat_exec_ok = ! sim_brk_summ;
+#endif
+        while (reason == 0) {
+            if (sim_interval <= 0) {
+#if FEATURE_TIME_EXCL_EVENTS
+                delta += sim_os_msec() - start;
+#endif
+                reason = sim_process_event();
+#if FEATURE_TIME_EXCL_EVENTS
+                start = sim_os_msec();
+#endif
+                if (reason != 0)
+                    break;
+            }
+            reason = control_unit();
+            ++ sys_stats.total_cycles;
+            sim_interval--;
+            if (cancel) {
+                if (reason == 0)
+                    reason = cancel;
+            }
+            if (opt_debug) {
+                log_msg(DEBUG_MSG, "MAIN::CU", "Debugging enabled; switching to instrumented loop.\n");
+                state_invalidate_cache();
+                break;
+            }
+        }
+#if FEAT_BLOCK_CACHE
+        block_exec_ok = 0;
+#endif
+#if FEAT_REPEAT_LOOP
+        repeat_exec_ok = 0;
+#endif
+    }
+
     unsigned prev_seg = PPR.PSR;
     int prev_debug = opt_debug;
     // Loop until it's time to bounce back to SIMH
@@ -1015,6 +1449,8 @@ t_stat sim_instr(void)
         log_msg(INFO_MSG, "CU", "Step: %.1f seconds: %d cycles at %d cycles/sec, %d instructions at %d instr/sec\n",
             (float) delta / 1000, ncycles, ncycles*1000/delta, sys_stats.n_instr, sys_stats.n_instr*1000/delta);
 
+    brk_index_valid = 0;
+    mem_attr_set_all(MEM_ATTR_BRK);     // breakpoints may change at the prompt
     save_to_simh();     // pack private variables into SIMH's world
     flush_logs();
 
@@ -1325,8 +1761,7 @@ static t_stat control_unit(void)
 
     switch(cpu.cycle) {
         case DIS_cycle: {
-            // TODO: Use SIMH's idle facility
-            // Until then, just freewheel
+            // Skip ahead to the next SIMH event; see dis_idle().
             // 
             // We should probably use the inhibit flag to determine
             // whether or not to examine faults.  However, it appears
@@ -1358,6 +1793,7 @@ static t_stat control_unit(void)
             } else {
                 // WARNING: The only thing in the queue might be a "step"
                 log_msg(DEBUG_MSG, "CU", "Delaying until an interrupt is set (%d entries are in the SIMH queue).\n", n);
+                dis_idle();
             }
             break;
         }
@@ -1394,6 +1830,13 @@ static t_stat control_unit(void)
                     }
                 }
             }
+#if FEAT_BLOCK_CACHE
+            if (block_exec_ok && ! cu.xde && ! cu.xdo && ! cu.rpt && ! cu.rd) {
+                block_t *bp = block_lookup();
+                if (bp != NULL && bp->n != 0 && block_run(bp) != 0)
+                    break;
+            }
+#endif
             // Fetch a pair of words
             // AL39, 1-13: for fetches, procedure pointer reg (PPR) is
             // ignored. [PPR IC is a dup of IC]
@@ -1406,10 +1849,21 @@ static t_stat control_unit(void)
                 cpu.cycle = FAULT_cycle;
                 cpu.irodd_invalid = 1;
             } else {
-                decode_instr(word);
-                t_uint64 simh_addr = addr_emul_to_simh(get_addr_mode(), PPR.PSR, PPR.IC - PPR.IC % 2);
+                // Pairs never cross a page, so the even word is just below
+                // the odd word that was fetched last
+                decode_instr_abs(word, cpu.read_addr - 1);
                 cpu.irodd_invalid = 0;
                 cpu.cycle = EXEC_cycle;
+#if FEAT_BLOCK_CACHE
+                if (block_exec_ok && block_lookup() == NULL) {
+                    // Only spend time on blocks for code that is hot
+                    uint8 *heatp = &block_heat[(PPR.IC ^ (PPR.PSR << 4)) & MASKBITS(BLOCK_BITS)];
+                    if (++ *heatp >= BLOCK_HOT) {
+                        *heatp = 0;
+                        block_build(cpu.read_addr - 1 + PPR.IC % 2);
+                    }
+                }
+#endif
             }
             cpu.IC_abs = cpu.read_addr;
             cu.instr_fetch = 0;
@@ -1682,6 +2136,10 @@ static t_stat control_unit(void)
             } else if (! cpu.ic_odd) {
                 if (opt_debug)
                     log_msg(DEBUG_MSG, "CU", "Cycle = EXEC, even instr\n");
+                // An even instruction under RPT is run again without being
+                // fetched; reset its address as decoding would have done
+                if ((cu.rpt || cu.rd) && ! cu.repeat_first)
+                    decode_setup();
             } else {
                 if (opt_debug)
                     log_msg(DEBUG_MSG, "CU", "Cycle = EXEC, odd instr\n");
@@ -1698,11 +2156,11 @@ static t_stat control_unit(void)
                     }
                     break;
                 }
-                decode_instr(cu.IRODD);
+                decode_instr_abs(cu.IRODD, cpu.IC_abs);
             }
 
             // Do we have a breakpoint here?
-            if (sim_brk_summ) {
+            if (sim_brk_summ && brk_page_flagged(get_addr_mode(), PPR.PSR, PPR.IC)) {
                 t_uint64 simh_addr = addr_emul_to_simh(get_addr_mode(), PPR.PSR, PPR.IC);
                 if (sim_brk_test (simh_addr, SWMASK ('E'))) {
                     // BUG: misses breakpoints on target of xed, rpt, and
@@ -1763,7 +2221,6 @@ static t_stat control_unit(void)
                     log_msg(WARN_MSG, "CU", "Repeat instruction terminated by fault.\n");
                     cu.rpt = 0;
                     cu.rd = 0;
-                    extern DEVICE cpu_dev; if(opt_debug) {-- opt_debug; -- cpu_dev.dctrl;};
                 }
             } else {
                 /* No Fault */
@@ -1779,104 +2236,15 @@ static t_stat control_unit(void)
                             cpu.cycle = FETCH_cycle;
                     } else {
                         // Executed a repeated instruction
-                        // log_msg(WARN_MSG, "CU", "Address handing for repeated instr was probably wrong.\n");
-                        // Check for tally runout or termination conditions
-                        uint t = reg_X[0] >> 10; // bits 0..7 of 18bit register
-                        if (cu.repeat_first) {
-                            if (opt_debug) log_msg(DEBUG_MSG, "CU", "Repeat-first flag is on.\n");
-                            // Instr RD gets two repeat firsts -- one for the even instr and one for the odd
-                            // FIXME: For RPD, should odd addr calc occur before even instr exec?  Guessing not...
-                            if (cu.rpt || (cu.rd && ! do_odd)) {
-                                if (t == 0)
-                                    t = 256;
-                                cu.repeat_first = 0;
-                                if (opt_debug) log_msg(DEBUG_MSG, "CU", "Turning off repeat-first flag.\n");
-                            }
-                        }
-                        --t;
-                        reg_X[0] = ((t&0377) << 10) | (reg_X[0] & 01777);
-                        // Note that we increment X[n] here, not in the APU.
-                        // So, for instructions like cmpaq, the index register
-                        // points to the entry after the one found.
-                        int n = cu.IR.mods.single.tag & 07;
-                        if (cu.rpt) {
-                            reg_X[n] += cu.delta;
-                            if (opt_debug) log_msg(DEBUG_MSG, "CU", "Incrementing X[%d] by %#o to %#o.\n", n, cu.delta, reg_X[n]);
-                        } else if (cu.rd) {
-                            if (! do_odd) {
-                                if (((reg_X[0] >> 9) & 1) == 1) {
-                                    reg_X[n] += cu.delta;
-                                    log_msg(INFO_MSG, "CU", "Incrementing X[%d] by %#o to %#o.\n", n, cu.delta, reg_X[n]);
-                                } else
-                                    log_msg(INFO_MSG, "CU", "Not Incrementing X[%d] by %#o; still %#o.\n", n, cu.delta, reg_X[n]);
-                            } else {
-                                if (((reg_X[0] >> 8) & 1) == 1) {
-                                    reg_X[n] += cu.delta;
-                                    log_msg(INFO_MSG, "CU", "Incrementing X[%d] by %#o to %#o.\n", n, cu.delta, reg_X[n]);
-                                } else
-                                    log_msg(INFO_MSG, "CU", "Not Incrementing X[%d] by %#o; still %#o.\n", n, cu.delta, reg_X[n]);
-                            }
-                        }
-                        // Note that the code in bootload_tape.alm expects that
-                        // the tally runout *not* be set when both the
-                        // termination condition is met and bits 0..7 of
-                        // reg X[0] hits zero.
-                        const flag_t orig_rpt = cu.rpt;
-                        const flag_t orig_rd = cu.rd;
-                        if (t == 0) {
-                            IR.tally_runout = 1;
-                            cu.rpt = 0;
-                            cu.rd = 0;
-                            if (opt_debug) log_msg(DEBUG_MSG, "CU", "Repeated instruction hits tally runout; halting rpt.\n");
-                            extern DEVICE cpu_dev; -- opt_debug; -- cpu_dev.dctrl;
-                        }
-                        // Check for termination conditions -- even if we hit
-                        // the tally runout
-                        // Note that register X[0] is 18 bits
-                        int terminate = 0;
-                        if (orig_rpt || (orig_rd && do_odd)) {
-                            if (getbit18(reg_X[0], 11))
-                                terminate |= IR.zero;
-                            if (getbit18(reg_X[0], 12))
-                                terminate |= ! IR.zero;
-                            if (getbit18(reg_X[0], 13))
-                                terminate |= IR.neg;
-                            if (getbit18(reg_X[0], 14))
-                                terminate |= ! IR.neg;
-                            if (getbit18(reg_X[0], 15))
-                                terminate |= IR.carry;
-                            if (getbit18(reg_X[0], 16))
-                                terminate |= ! IR.carry;
-                            if (getbit18(reg_X[0], 17)) {
-                                log_msg(DEBUG_MSG, "CU", "Checking termination conditions for overflows.\n");
-                                // Process overflows -- BUG: what are all the
-                                // types of overflows?
-                                if (IR.overflow || IR.exp_overflow) {
-                                    if (IR.overflow_mask)
-                                        IR.overflow = 1;
-                                    else
-                                        fault_gen(overflow_fault);
-                                    terminate = 1;
-                                }
-                            }
-                        }
-                        if (terminate) {
-                            cu.rpt = 0;
-                            cu.rd = 0;
-                            log_msg(DEBUG_MSG, "CU", "Repeated instruction meets termination condition.\n");
-                            IR.tally_runout = 0;
-                            extern DEVICE cpu_dev; if(opt_debug) {-- opt_debug; -- cpu_dev.dctrl;};
-                            // BUG: need IC incr, etc
-                        } else {
-                            if (! IR.tally_runout)
-                                if (opt_debug>0) log_msg(DEBUG_MSG, "CU", "Repeated instruction will continue.\n");
-                        }
-                        if (cu.rd) {
-                            if (do_odd) {
-                                -- PPR.IC;
-                                if (opt_debug>0) log_msg(DEBUG_MSG, "CU", "Resetting IC to %#o for next loop.\n", PPR.IC);
-                            }
-                        }
+                        repeat_tally(do_odd);
+#if FEAT_REPEAT_LOOP
+                        // Run the remaining repetitions without going
+                        // back through the CU cycles
+                        if (repeat_exec_ok && ! doing_xde && ! doing_xdo && cpu.cycle == EXEC_cycle && ! cpu.trgo)
+                            if ((cu.rpt && PPR.IC == IC_temp) || (cu.rd && do_odd && PPR.IC + 1 == IC_temp))
+                                if (repeat_loop() != 0)
+                                    break;
+#endif
                     }
                 }
                 // Retest cu.rpt -- we might have just finished repeating
@@ -1995,6 +2363,258 @@ static t_stat control_unit(void)
 }
 
 
+//=============================================================================
+
+/*
+ * repeat_tally()
+ *
+ * Bookkeeping after one repetition of an instruction under RPT or RPD:
+ * count down the tally in X[0], step the index register, and check the
+ * termination conditions.  Clears cu.rpt and cu.rd when the repeat is
+ * finished.  For RPD, backs the IC up to the even instruction after the
+ * odd one if the loop continues.
+ */
+
+static void repeat_tally(flag_t do_odd)
+{
+    // log_msg(WARN_MSG, "CU", "Address handing for repeated instr was probably wrong.\n");
+    // Check for tally runout or termination conditions
+    uint t = reg_X[0] >> 10; // bits 0..7 of 18bit register
+    if (cu.repeat_first) {
+        if (opt_debug) log_msg(DEBUG_MSG, "CU", "Repeat-first flag is on.\n");
+        // Instr RD gets two repeat firsts -- one for the even instr and one for the odd
+        // FIXME: For RPD, should odd addr calc occur before even instr exec?  Guessing not...
+        if (cu.rpt || (cu.rd && ! do_odd)) {
+            if (t == 0)
+                t = 256;
+            cu.repeat_first = 0;
+            if (opt_debug) log_msg(DEBUG_MSG, "CU", "Turning off repeat-first flag.\n");
+        }
+    }
+    --t;
+    reg_X[0] = ((t&0377) << 10) | (reg_X[0] & 01777);
+    // Note that we increment X[n] here, not in the APU.
+    // So, for instructions like cmpaq, the index register
+    // points to the entry after the one found.
+    int n = cu.IR.mods.single.tag & 07;
+    if (cu.rpt) {
+        reg_X[n] += cu.delta;
+        if (opt_debug) log_msg(DEBUG_MSG, "CU", "Incrementing X[%d] by %#o to %#o.\n", n, cu.delta, reg_X[n]);
+    } else if (cu.rd) {
+        if (! do_odd) {
+            if (((reg_X[0] >> 9) & 1) == 1) {
+                reg_X[n] += cu.delta;
+                if (opt_debug) log_msg(DEBUG_MSG, "CU", "Incrementing X[%d] by %#o to %#o.\n", n, cu.delta, reg_X[n]);
+            } else if (opt_debug)
+                log_msg(DEBUG_MSG, "CU", "Not Incrementing X[%d] by %#o; still %#o.\n", n, cu.delta, reg_X[n]);
+        } else {
+            if (((reg_X[0] >> 8) & 1) == 1) {
+                reg_X[n] += cu.delta;
+                if (opt_debug) log_msg(DEBUG_MSG, "CU", "Incrementing X[%d] by %#o to %#o.\n", n, cu.delta, reg_X[n]);
+            } else if (opt_debug)
+                log_msg(DEBUG_MSG, "CU", "Not Incrementing X[%d] by %#o; still %#o.\n", n, cu.delta, reg_X[n]);
+        }
+    }
+    // Note that the code in bootload_tape.alm expects that
+    // the tally runout *not* be set when both the
+    // termination condition is met and bits 0..7 of
+    // reg X[0] hits zero.
+    const flag_t orig_rpt = cu.rpt;
+    const flag_t orig_rd = cu.rd;
+    if (t == 0) {
+        IR.tally_runout = 1;
+        cu.rpt = 0;
+        cu.rd = 0;
+        if (opt_debug) log_msg(DEBUG_MSG, "CU", "Repeated instruction hits tally runout; halting rpt.\n");
+    }
+    // Check for termination conditions -- even if we hit
+    // the tally runout
+    // Note that register X[0] is 18 bits
+    int terminate = 0;
+    if (orig_rpt || (orig_rd && do_odd)) {
+        if (getbit18(reg_X[0], 11))
+            terminate |= IR.zero;
+        if (getbit18(reg_X[0], 12))
+            terminate |= ! IR.zero;
+        if (getbit18(reg_X[0], 13))
+            terminate |= IR.neg;
+        if (getbit18(reg_X[0], 14))
+            terminate |= ! IR.neg;
+        if (getbit18(reg_X[0], 15))
+            terminate |= IR.carry;
+        if (getbit18(reg_X[0], 16))
+            terminate |= ! IR.carry;
+        if (getbit18(reg_X[0], 17)) {
+            if (opt_debug) log_msg(DEBUG_MSG, "CU", "Checking termination conditions for overflows.\n");
+            // Process overflows -- BUG: what are all the
+            // types of overflows?
+            if (IR.overflow || IR.exp_overflow) {
+                if (IR.overflow_mask)
+                    IR.overflow = 1;
+                else
+                    fault_gen(overflow_fault);
+                terminate = 1;
+            }
+        }
+    }
+    if (terminate) {
+        cu.rpt = 0;
+        cu.rd = 0;
+        if (opt_debug) log_msg(DEBUG_MSG, "CU", "Repeated instruction meets termination condition.\n");
+        IR.tally_runout = 0;
+        // BUG: need IC incr, etc
+    } else {
+        if (! IR.tally_runout)
+            if (opt_debug>0) log_msg(DEBUG_MSG, "CU", "Repeated instruction will continue.\n");
+    }
+    if (cu.rd) {
+        if (do_odd) {
+            -- PPR.IC;
+            if (opt_debug>0) log_msg(DEBUG_MSG, "CU", "Resetting IC to %#o for next loop.\n", PPR.IC);
+        }
+    }
+}
+
+#if FEAT_REPEAT_LOOP
+
+//=============================================================================
+
+/*
+ * repeat_loop()
+ *
+ * Fast path for the rest of an RPT or RPD loop.  Called by the EXEC cycle
+ * after a repetition has finished without a fault and the loop is still
+ * going.  The repeated instruction (or pair, for RPD) is decoded once and
+ * run in place, with the bookkeeping done by repeat_tally().  We stop when
+ * the repeat finishes, when an instruction changes the flow of control, or
+ * when a fault, an interrupt, or the end of the SIMH time slice needs the
+ * regular CU cycles.
+ *
+ * The CU state is left as the EXEC cycle would have left it after the
+ * last repetition.  Only the first repetition goes into the instruction
+ * history, so a long loop doesn't flood it.
+ *
+ * Returns non-zero if a repetition faulted.
+ */
+
+static int repeat_loop(void)
+{
+    instr_t instrs[2];
+    uint first = (cu.rd) ? 0 : PPR.IC % 2;
+    uint last = (cu.rd) ? 1 : first;
+
+    // Pairs never cross a page, so the even word is just below the
+    // buffered odd word
+    if (last == 1) {
+        if (cpu.irodd_invalid)
+            return 0;
+        decode_instr_abs(cu.IRODD, cpu.IC_abs);
+        instrs[1] = cu.IR;
+    }
+    if (first == 0) {
+#if FEAT_MEM_CHECK_UNINIT
+        if (! MEM_IS_WRITTEN(cpu.IC_abs - 1))
+            return 0;
+#endif
+        decode_instr_abs(Mem[cpu.IC_abs - 1], cpu.IC_abs - 1);
+        instrs[0] = cu.IR;
+    }
+
+    for (;;) {
+        if (cancel || events.any || sim_interval <= 0 || opt_debug || cpu.irodd_invalid)
+            return 0;
+        if (cu.rd) {
+            // Leave a tally runout on the even instruction to the EXEC
+            // cycle; the odd one is then run without repeating
+            if ((reg_X[0] >> 10) < 2)
+                return 0;
+            // Charge the FETCH cycle of the pair
+            ++ sys_stats.total_cycles;
+            -- sim_interval;
+        }
+        for (uint i = first; i <= last; ++i) {
+            ++ sys_stats.total_cycles;
+            -- sim_interval;
+            cpu.ic_odd = i;
+            TPR.TSR = PPR.PSR;
+            TPR.TRR = PPR.PRR;
+            cu.IR = instrs[i];
+            decode_setup();
+            uint IC_temp = PPR.IC;
+            execute_ir();
+
+            if (events.any && events.low_group && events.low_group < 7) {
+                log_msg(WARN_MSG, "CU", "Fault detected after instruction execution\n");
+                if (PPR.IC != IC_temp) {
+                    log_msg(INFO_MSG, "CU", "Restoring IC to %06o (from %06o)\n",
+                        IC_temp, PPR.IC);
+                    PPR.IC = IC_temp;
+                }
+                log_msg(WARN_MSG, "CU", "Repeat instruction terminated by fault.\n");
+                cu.rpt = 0;
+                cu.rd = 0;
+                return 1;
+            }
+            flag_t moved = cpu.cycle != EXEC_cycle || cpu.trgo || PPR.IC != IC_temp;
+            repeat_tally(i);
+            if (moved || ! (cu.rpt || cu.rd))
+                return 0;
+            if (i < last)
+                ++ PPR.IC;
+        }
+    }
+}
+
+#endif
+
+//=============================================================================
+
+/*
+ *  dis_idle()
+ *
+ *  Called by the DIS cycle when no interrupt is pending.  Nothing can
+ *  happen until the next entry on the SIMH event queue fires, so advance
+ *  the cycle count (and with it the virtual calendar, see scu.c) straight
+ *  to that event instead of freewheeling one cycle at a time.
+ *
+ *  While idling, the virtual calendar can run far ahead of the host's clock,
+ *  e.g. when waiting on operator input.  Once it is ahead by more than
+ *  a few milliseconds, we sleep until the host catches up.  That keeps an
+ *  idle system from burning host CPU.  Time spent executing instructions
+ *  is not paced.
+ */
+
+static void dis_idle(void)
+{
+    static t_uint64 idle_end_cycles;    // total_cycles when last idle period ended
+    static t_uint64 base_cycles;        // pacing baseline, virtual
+    static uint32 base_msec;            // pacing baseline, host
+
+    if (sys_stats.total_cycles - idle_end_cycles > 1000) {
+        // Did real work since the last idle period; restart pacing
+        base_cycles = sys_stats.total_cycles;
+        base_msec = sim_os_msec();
+    }
+
+    if (sim_interval > 1) {
+        // Leave one cycle for the caller to count
+        sys_stats.total_cycles += sim_interval - 1;
+        sim_interval = 1;
+    }
+    idle_end_cycles = sys_stats.total_cycles + 1;
+
+    uint32 speed = (sys_opts.clock_speed != 0) ? sys_opts.clock_speed : 250000;
+    t_uint64 i_cycles = (sys_stats.total_cycles - base_cycles) * 2 / 3;    // fetch, exec, exec
+    uint32 virt_msec = i_cycles * 1000 / speed;
+    uint32 host_msec = sim_os_msec() - base_msec;
+    if (virt_msec > host_msec + 10) {
+        uint32 ms = virt_msec - host_msec;
+        if (ms > 100)
+            ms = 100;   // stay responsive to the SIMH console
+        (void) sim_os_ms_sleep(ms);
+    }
+}
+
 //=============================================================================
 
 /*
@@ -2217,6 +2837,60 @@ int fetch_word(uint addr, t_uint64 *wordp)
 }
 
 
+//=============================================================================
+
+static void brk_index_reset(void)
+{
+    memset(brk_abs_known, 0, sizeof(brk_abs_known));
+    memset(brk_seg_known, 0, sizeof(brk_seg_known));
+    brk_index_valid = 1;
+}
+
+/*
+ * brk_page_flagged()
+ *
+ * Returns non-zero if any SIMH breakpoint might be set on the page that
+ * holds the given address.  Callers should only pay for building a packed
+ * address and calling sim_brk_test() when this returns true.
+ */
+
+int brk_page_flagged(addr_modes_t mode, uint segno, uint offset)
+{
+    if (! brk_index_valid)
+        return 1;
+
+    uint32 *known, *flagged;
+    uint page;
+    if (mode == ABSOLUTE_mode) {
+        if (offset >= MAXMEMSIZE)
+            return 1;
+        known = brk_abs_known;
+        flagged = brk_abs_flagged;
+        page = offset >> BRK_PAGE_BITS;
+    } else if (mode == APPEND_mode) {
+        if (segno >> 15 != 0 || offset >> 18 != 0)
+            return 1;   // let addr_emul_to_simh() complain
+        known = brk_seg_known;
+        flagged = brk_seg_flagged;
+        page = (segno << (18 - BRK_PAGE_BITS)) | (offset >> BRK_PAGE_BITS);
+    } else
+        return 1;       // BAR mode is rare enough to always ask SIMH
+
+    uint32 bit = (uint32) 1 << (page & 31);
+    if ((known[page >> 5] & bit) == 0) {
+        uint base = offset & ~ (uint) MASKBITS(BRK_PAGE_BITS);
+        int found = 0;
+        for (uint i = 0; i < (1 << BRK_PAGE_BITS) && ! found; ++i)
+            found = sim_brk_fnd((t_addr) addr_emul_to_simh(mode, segno, base + i)) != NULL;
+        if (found)
+            flagged[page >> 5] |= bit;
+        else
+            flagged[page >> 5] &= ~bit;
+        known[page >> 5] |= bit;
+    }
+    return (flagged[page >> 5] & bit) != 0;
+}
+
 //=============================================================================
 
 /*
@@ -2229,25 +2903,6 @@ int fetch_word(uint addr, t_uint64 *wordp)
 
 int fetch_abs_word(uint addr, t_uint64 *wordp)
 {
-
-#define CONFIG_DECK_LOW 012000
-#define CONFIG_DECK_LEN 010000
-
-    // TODO: Efficiency: If the compiler doesn't do it for us, the tests
-    // below should be combined under a single min/max umbrella.
-    if (addr >= IOM_MBX_LOW && addr < IOM_MBX_LOW + IOM_MBX_LEN) {
-        log_msg(DEBUG_MSG, "CU::fetch", "Fetch from IOM mailbox area for addr %#o\n", addr);
-    }
-    if (addr >= DN355_MBX_LOW && addr < DN355_MBX_LOW + DN355_MBX_LEN) {
-        log_msg(DEBUG_MSG, "CU::fetch", "Fetch from DN355 mailbox area for addr %#o\n", addr);
-    }
-    if (addr >= CONFIG_DECK_LOW && addr < CONFIG_DECK_LOW + CONFIG_DECK_LEN) {
-        log_msg(DEBUG_MSG, "CU::fetch", "Fetch from CONFIG DECK area for addr %#o\n", addr);
-    }
-    if (addr <= 030) {
-        log_msg(DEBUG_MSG, "CU::fetch", "Fetch from 0..030 for addr %#o\n", addr);
-    }
-
     if (addr >= MAXMEMSIZE) {
             log_msg(ERR_MSG, "CU::fetch", "Addr %#o (%d decimal) is too large\n", addr, addr);
             (void) cancel_run(STOP_BUG);
@@ -2256,23 +2911,38 @@ int fetch_abs_word(uint addr, t_uint64 *wordp)
 
     cpu.read_addr = addr;   // Should probably be in scu
 
-#if FEAT_MEM_CHECK_UNINIT
-    {
-    if (Mem[addr] == ~ (t_uint64) 0) {      // absolute memory reference
-        *wordp = 0;
-        if (sys_opts.warn_uninit)
-            log_msg(WARN_MSG, "CU::fetch", "Fetch from uninitialized absolute location %#o.\n", addr);
-    } else
-        *wordp = Mem[addr];
-    }
-#else
     *wordp = Mem[addr]; // absolute memory reference
-#endif
+    if (mem_attr[addr >> MEM_ATTR_PAGE_BITS] & MEM_ATTR_FETCH_SLOW)
+        fetch_abs_slow(addr, wordp);
 
-    if (get_addr_mode() == BAR_mode)
+    if (opt_debug && get_addr_mode() == BAR_mode)
         log_msg(DEBUG_MSG, "CU::fetch-abs", "fetched word at %#o\n", addr);
 
-    if (sim_brk_summ) {
+    return 0;
+}
+
+//=============================================================================
+
+/*
+ * fetch_abs_slow()
+ *
+ * The part of fetch_abs_word() for pages with attributes:  region logging,
+ * uninitialized memory warnings, and absolute mode breakpoints.
+ */
+
+static void fetch_abs_slow(uint addr, t_uint64 *wordp)
+{
+    uint page = addr >> MEM_ATTR_PAGE_BITS;
+    uint8 attr = mem_attr[page];
+
+    if (attr & (MEM_ATTR_TRACE | MEM_ATTR_WATCH))
+        mem_region_log("Fetch from", addr, *wordp, attr);
+#if FEAT_MEM_CHECK_UNINIT
+    if ((attr & MEM_ATTR_UNINIT) && sys_opts.warn_uninit && ! MEM_IS_WRITTEN(addr))
+        log_msg(WARN_MSG, "CU::fetch", "Fetch from uninitialized absolute location %#o.\n", addr);
+#endif
+
+    if ((attr & MEM_ATTR_BRK) && mem_attr_brk(page)) {
         // Check for absolute mode breakpoints.  Note that fetch_appended()
         // has its own test for appending mode breakpoints.
         t_uint64 simh_addr = addr_emul_to_simh(ABSOLUTE_mode, 0, addr);
@@ -2284,8 +2954,6 @@ int fetch_abs_word(uint addr, t_uint64 *wordp)
             (void) cancel_run(STOP_IBKPT);
         }
     }
-
-    return 0;
 }
 
 //=============================================================================
@@ -2344,28 +3012,40 @@ int store_word(uint addr, t_uint64 word)
 
 int store_abs_word(uint addr, t_uint64 word)
 {
-
-    // TODO: Efficiency: If the compiler doesn't do it for us, the tests
-    // below should be combined under a single min/max umbrella.
-    if (addr >= IOM_MBX_LOW && addr < IOM_MBX_LOW + IOM_MBX_LEN) {
-        log_msg(DEBUG_MSG, "CU::store", "Store to IOM mailbox area for addr %#o\n", addr);
-    }
-    if (addr >= DN355_MBX_LOW && addr < DN355_MBX_LOW + DN355_MBX_LEN) {
-        log_msg(DEBUG_MSG, "CU::store", "Store to DN355 mailbox area for addr %#o\n", addr);
-    }
-    if (addr >= CONFIG_DECK_LOW && addr < CONFIG_DECK_LOW + CONFIG_DECK_LEN) {
-        log_msg(DEBUG_MSG, "CU::store", "Store to CONFIG DECK area for addr %#o\n", addr);
-    }
-    if (addr <= 030) {
-        //log_msg(DEBUG_MSG, "CU::store", "Fetch from 0..030 for addr %#o\n", addr);
-    }
-
     if (addr >= MAXMEMSIZE) {
-            log_msg(ERR_MSG, "CU::store", "Addr %#o (%d decimal) is too large\n");
+            log_msg(ERR_MSG, "CU::store", "Addr %#o (%d decimal) is too large\n", addr, addr);
             (void) cancel_run(STOP_BUG);
             return 1;
     }
-    if (sim_brk_summ) {
+
+    if (mem_attr[addr >> MEM_ATTR_PAGE_BITS] & MEM_ATTR_STORE_SLOW)
+        store_abs_slow(addr, word);
+    else
+        Mem[addr] = word;   // absolute memory reference
+
+    if (opt_debug && get_addr_mode() == BAR_mode)
+        log_msg(DEBUG_MSG, "CU::store-abs", "stored word to %#o\n", addr);
+    return 0;
+}
+
+//=============================================================================
+
+/*
+ * store_abs_slow()
+ *
+ * The part of store_abs_word() for pages with attributes:  region logging
+ * and absolute mode breakpoints before the store, and the bookkeeping of
+ * mem_stored() after it.
+ */
+
+static void store_abs_slow(uint addr, t_uint64 word)
+{
+    uint page = addr >> MEM_ATTR_PAGE_BITS;
+    uint8 attr = mem_attr[page];
+
+    if (attr & (MEM_ATTR_TRACE | MEM_ATTR_WATCH))
+        mem_region_log("Store to", addr, word, attr);
+    if ((attr & MEM_ATTR_BRK) && mem_attr_brk(page)) {
         // Check for absolute mode breakpoints.  Note that store_appended()
         // has its own test for appending mode breakpoints.
         t_uint64 simh_addr = addr_emul_to_simh(ABSOLUTE_mode, 0, addr);
@@ -2391,25 +3071,334 @@ int store_abs_word(uint addr, t_uint64 word)
                 log_msg(NOTIFY_MSG, "CU::store", "Write to a location that has an unknown type of breakpoint, address %#o, breakpoint %o\n", addr, mask);
                 (void) cancel_run(STOP_IBKPT);
             }
-            t_uint64 old = Mem[addr];
-            if (old == ~ (t_uint64) 0)
-                old = 0;
-            log_msg(INFO_MSG, "CU::store", "Address %08o: value was %012llo, storing %012llo\n", addr, old, word);
+            log_msg(INFO_MSG, "CU::store", "Address %08o: value was %012llo, storing %012llo\n", addr, Mem[addr], word);
         }
     }
 
     Mem[addr] = word;   // absolute memory reference
-    if (addr == cpu.IC_abs) {
-        log_msg(INFO_MSG, "CU::store", "Flagging cached odd instruction from %o as invalidated.\n", addr);
-        cpu.irodd_invalid = 1;
+    mem_stored(addr, addr);
+}
+
+//=============================================================================
+
+/*
+ * mem_direct_ok()
+ *
+ * Returns true if the absolute words lo .. hi may be read and written
+ * directly via Mem[] instead of via fetch_abs_word() and store_abs_word().
+ * That is the case unless debug output, watched regions, uninitialized
+ * memory checks, or absolute mode breakpoints would need to see the
+ * individual accesses.  Callers storing directly must report the stored
+ * range via mem_stored().
+ */
+
+int mem_direct_ok(uint lo, uint hi)
+{
+    if (hi >= MAXMEMSIZE || opt_debug)
+        return 0;
+    uint8 slow = MEM_ATTR_WATCH;
+#if FEAT_MEM_CHECK_UNINIT
+    if (sys_opts.warn_uninit)
+        slow |= MEM_ATTR_UNINIT;
+#endif
+    for (uint page = lo >> MEM_ATTR_PAGE_BITS; page <= hi >> MEM_ATTR_PAGE_BITS; ++page) {
+        uint8 attr = mem_attr[page];
+        if ((attr & slow) || ((attr & MEM_ATTR_BRK) && mem_attr_brk(page)))
+            return 0;
     }
-    if (get_addr_mode() == BAR_mode)
-        log_msg(DEBUG_MSG, "CU::store-abs", "stored word to %#o\n", addr);
+    return 1;
+}
+
+//=============================================================================
+
+/*
+ * mem_stored()
+ *
+ * Apply the side effects of store_abs_word() to a range of words that were
+ * stored directly into Mem[]:  mark them as written and invalidate any
+ * predecoded or cached instructions and the cached odd instruction.  Only
+ * pages with the UNINIT or CODE attributes need any work.
+ */
+
+void mem_stored(uint lo, uint hi)
+{
+    for (uint page = lo >> MEM_ATTR_PAGE_BITS; page <= hi >> MEM_ATTR_PAGE_BITS; ++page) {
+        uint8 attr = mem_attr[page];
+        if ((attr & (MEM_ATTR_UNINIT | MEM_ATTR_CODE)) == 0)
+            continue;
+        uint plo = page << MEM_ATTR_PAGE_BITS;
+        uint phi = plo + (1 << MEM_ATTR_PAGE_BITS) - 1;
+        if (plo < lo)
+            plo = lo;
+        if (phi > hi)
+            phi = hi;
+#if FEAT_MEM_CHECK_UNINIT
+        if (attr & MEM_ATTR_UNINIT) {
+            for (uint addr = plo; addr <= phi; ++addr)
+                MEM_MARK_WRITTEN(addr);
+            if (Mem_written[phi >> 5] == ~ (uint32) 0)
+                mem_attr_check_written(page);
+        }
+#endif
+        if (attr & MEM_ATTR_CODE) {
+            for (uint addr = plo; addr <= phi; ++addr) {
+                predecode_t *pp = &predecode[addr & MASKBITS(PREDECODE_BITS)];
+                if (pp->tag == addr + 1)
+                    pp->tag = 0;
+            }
+#if FEAT_BLOCK_CACHE
+            for (uint blk = plo / BLOCK_MAX; blk <= phi / BLOCK_MAX; ++blk)
+                if (block_code_map[blk / 8] & (1 << (blk % 8))) {
+                    cpu_block_flush();
+                    break;
+                }
+#endif
+            if (cpu.IC_abs >= plo && cpu.IC_abs <= phi) {
+                log_msg(INFO_MSG, "CU::store", "Flagging cached odd instruction from %o as invalidated.\n", cpu.IC_abs);
+                cpu.irodd_invalid = 1;
+            }
+        }
+    }
+}
+
+//=============================================================================
+
+/*
+ * mem_attr_init()
+ *
+ * Once-only setup of the memory attribute map.  Called after Mem[] has
+ * been allocated.  Every page starts out as possibly holding unwritten
+ * words and breakpoints; the mailbox and config deck areas get regions
+ * that are logged when debugging.
+ */
+
+void mem_attr_init(void)
+{
+    mem_attr_set_all(MEM_ATTR_BRK);
+#if FEAT_MEM_CHECK_UNINIT
+    mem_attr_set_all(MEM_ATTR_UNINIT);
+#endif
+    (void) mem_region_add(0, 030, MEM_ATTR_TRACE, "low memory");
+    (void) mem_region_add(IOM_MBX_LOW, IOM_MBX_LOW + IOM_MBX_LEN - 1, MEM_ATTR_TRACE, "IOM mailbox");
+    (void) mem_region_add(DN355_MBX_LOW, DN355_MBX_LOW + DN355_MBX_LEN - 1, MEM_ATTR_TRACE, "DN355 mailbox");
+    (void) mem_region_add(012000, 012000 + 010000 - 1, MEM_ATTR_TRACE, "CONFIG DECK");
+}
+
+//=============================================================================
+
+static void mem_attr_set_all(uint8 attr)
+{
+    for (uint page = 0; page < ARRAY_SIZE(mem_attr); ++page)
+        mem_attr[page] |= attr;
+}
+
+//=============================================================================
+
+/*
+ * mem_attr_refresh()
+ *
+ * Called on entry to sim_instr().  Breakpoints may have changed at the
+ * prompt, so every page gets its BRK bit back if any breakpoint is set.
+ * Pages that were filled in by code marking Mem_written directly (the
+ * loaders, the IOM boot setup) lose their UNINIT bit.
+ */
+
+static void mem_attr_refresh(void)
+{
+    for (uint page = 0; page < ARRAY_SIZE(mem_attr); ++page) {
+        if (sim_brk_summ)
+            mem_attr[page] |= MEM_ATTR_BRK;
+        else
+            mem_attr[page] &= ~ MEM_ATTR_BRK;
+#if FEAT_MEM_CHECK_UNINIT
+        if (mem_attr[page] & MEM_ATTR_UNINIT)
+            mem_attr_check_written(page);
+#endif
+    }
+}
+
+//=============================================================================
+
+/*
+ * mem_attr_brk()
+ *
+ * Returns non-zero if the page with the BRK attribute really might hold
+ * an absolute mode breakpoint.  Otherwise clears the attribute so the page
+ * takes the fast path from then on.  The attribute is kept while at the
+ * SIMH prompt because the breakpoint index is only valid within sim_instr().
+ */
+
+static int mem_attr_brk(uint page)
+{
+    if (sim_brk_summ && brk_page_flagged(ABSOLUTE_mode, 0, page << MEM_ATTR_PAGE_BITS))
+        return 1;
+    if (brk_index_valid)
+        mem_attr[page] &= ~ MEM_ATTR_BRK;
     return 0;
 }
 
 //=============================================================================
 
+/*
+ * mem_attr_check_written()
+ *
+ * Clear the UNINIT attribute of a page once every word in it has been
+ * written.
+ */
+
+static void mem_attr_check_written(uint page)
+{
+#if FEAT_MEM_CHECK_UNINIT
+    const uint32 *wp = &Mem_written[(page << MEM_ATTR_PAGE_BITS) >> 5];
+    for (uint i = 0; i < (1 << MEM_ATTR_PAGE_BITS) >> 5; ++i)
+        if (wp[i] != ~ (uint32) 0)
+            return;
+#endif
+    mem_attr[page] &= ~ MEM_ATTR_UNINIT;
+}
+
+//=============================================================================
+
+/*
+ * mem_attr_rebuild_regions()
+ *
+ * Recompute the TRACE and WATCH bits of the attribute map from the list
+ * of regions.
+ */
+
+static void mem_attr_rebuild_regions(void)
+{
+    for (uint page = 0; page < ARRAY_SIZE(mem_attr); ++page)
+        mem_attr[page] &= ~ (MEM_ATTR_TRACE | MEM_ATTR_WATCH);
+    for (int i = 0; i < mem_nregions; ++i) {
+        const mem_region_t *rp = &mem_regions[i];
+        for (uint page = rp->lo >> MEM_ATTR_PAGE_BITS; page <= rp->hi >> MEM_ATTR_PAGE_BITS; ++page)
+            mem_attr[page] |= rp->attr;
+    }
+}
+
+//=============================================================================
+
+/*
+ * mem_region_add()
+ *
+ * Give the absolute addresses lo .. hi an attribute that sends accesses
+ * to them through the slow paths of fetch_abs_word() and store_abs_word().
+ * Accesses to TRACE regions are logged when debugging; accesses to WATCH
+ * regions are always logged.
+ *
+ * Returns non-zero on error.
+ */
+
+int mem_region_add(uint lo, uint hi, uint8 attr, const char *name)
+{
+    if (lo > hi || hi >= MAXMEMSIZE) {
+        log_msg(ERR_MSG, "CU::mem-region", "Bad range %#o .. %#o for region %s.\n", lo, hi, name);
+        return 1;
+    }
+    if (mem_nregions == MEM_REGIONS_MAX) {
+        log_msg(ERR_MSG, "CU::mem-region", "Too many memory regions; cannot add %s.\n", name);
+        return 1;
+    }
+    mem_region_t *rp = &mem_regions[mem_nregions++];
+    rp->lo = lo;
+    rp->hi = hi;
+    rp->attr = attr;
+    strncpy(rp->name, name, sizeof(rp->name) - 1);
+    rp->name[sizeof(rp->name) - 1] = 0;
+    mem_attr_rebuild_regions();
+    return 0;
+}
+
+//=============================================================================
+
+/*
+ * mem_region_del()
+ *
+ * Remove the region with the given attribute that starts at lo.
+ *
+ * Returns non-zero if there is no such region.
+ */
+
+int mem_region_del(uint lo, uint8 attr)
+{
+    for (int i = 0; i < mem_nregions; ++i)
+        if (mem_regions[i].lo == lo && mem_regions[i].attr == attr) {
+            mem_regions[i] = mem_regions[-- mem_nregions];
+            mem_attr_rebuild_regions();
+            return 0;
+        }
+    return 1;
+}
+
+//=============================================================================
+
+/*
+ * mem_region_log()
+ *
+ * Log an access to an address in a page with the TRACE or WATCH attribute.
+ */
+
+static void mem_region_log(const char *what, uint addr, t_uint64 word, uint8 attr)
+{
+    if (! (attr & MEM_ATTR_WATCH) && ! opt_debug)
+        return;
+    for (int i = 0; i < mem_nregions; ++i) {
+        const mem_region_t *rp = &mem_regions[i];
+        if (addr < rp->lo || addr > rp->hi)
+            continue;
+        if (rp->attr & MEM_ATTR_WATCH)
+            log_msg(NOTIFY_MSG, "CU::watch", "%s watched region %s at %#o: %012llo\n", what, rp->name, addr, word);
+        else
+            log_msg(DEBUG_MSG, "CU::mem", "%s %s area for addr %#o\n", what, rp->name, addr);
+    }
+}
+
+//=============================================================================
+
+/*
+ * cmd_watch()
+ *
+ * SIMH command to list, add, and remove watched regions of absolute memory.
+ */
+
+int cmd_watch(int32 arg, char *buf)
+{
+    char cmd[20];
+    uint lo, hi;
+    int n = sscanf(buf, "%19s %o %o", cmd, &lo, &hi);
+    if (n <= 0 || strcmp(cmd, "list") == 0) {
+        int any = 0;
+        for (int i = 0; i < mem_nregions; ++i) {
+            const mem_region_t *rp = &mem_regions[i];
+            out_msg("%08o .. %08o  %s%s\n", rp->lo, rp->hi, rp->name,
+                (rp->attr & MEM_ATTR_WATCH) ? " (watched)" : "");
+            any = 1;
+        }
+        if (! any)
+            out_msg("No memory regions.\n");
+        return 0;
+    }
+    if (strcmp(cmd, "add") == 0 && n >= 2) {
+        if (n == 2)
+            hi = lo;
+        char name[24];
+        sprintf(name, "%o", lo);
+        return mem_region_add(lo, hi, MEM_ATTR_WATCH, name);
+    }
+    if (strcmp(cmd, "del") == 0 && n >= 2) {
+        if (mem_region_del(lo, MEM_ATTR_WATCH) != 0) {
+            out_msg("No watched region starts at %#o.\n", lo);
+            return 1;
+        }
+        return 0;
+    }
+    out_msg("USAGE: xwatch [list | add <addr> [<last-addr>] | del <addr>]\n");
+    return 1;
+}
+
+//=============================================================================
+
 /*
  * store_abs_pair()
  * 
@@ -2455,17 +3444,8 @@ int store_abs_pair(uint addr, t_uint64 word0, t_uint64 word1)
 
 int store_pair(uint addr, t_uint64 word0, t_uint64 word1)
 {
-
-    int ret;
-    uint Y = (addr % 2 == 0) ? addr : addr - 1;
-
-    if ((ret = store_word(Y, word0)) != 0) {
-        return ret;
-    }
-    if ((ret = store_word(Y+1, word1)) != 0) {
-        return ret;
-    }
-    return 0;
+    t_uint64 words[2] = { word0, word1 };
+    return store_yblock(addr, 1, 2, words);
 }
 
 //=============================================================================
@@ -2511,16 +3491,13 @@ int fetch_abs_pair(uint addr, t_uint64* word0p, t_uint64* word1p)
 
 int fetch_pair(uint addr, t_uint64* word0p, t_uint64* word1p)
 {
-    int ret;
-    uint Y = (addr % 2 == 0) ? addr : addr - 1;
-
-    if ((ret = fetch_word(Y, word0p)) != 0) {
-        return ret;
-    }
-    if ((ret = fetch_word(Y+1, word1p)) != 0) {
-        return ret;
+    t_uint64 words[2];
+    int ret = fetch_yblock(addr, 1, 2, words);
+    if (ret == 0) {
+        *word0p = words[0];
+        *word1p = words[1];
     }
-    return 0;
+    return ret;
 }
 
 //=============================================================================
@@ -2542,6 +3519,16 @@ int fetch_yblock(uint addr, int aligned, uint n, t_uint64 *wordsp)
     int ret;
     uint Y = (aligned) ? (addr / n) * n : addr;
 
+    // Whole blocks are translated once per page rather than once per word
+    addr_modes_t mode = get_addr_mode();
+    if (mode == APPEND_mode)
+        return fetch_appended_block(Y, n, wordsp);
+    if (mode == ABSOLUTE_mode && mem_direct_ok(Y, Y + n - 1)) {
+        memcpy(wordsp, &Mem[Y], n * sizeof(*wordsp));
+        cpu.read_addr = Y + n - 1;
+        return 0;
+    }
+
     for (uint i = 0; i < n; ++i)
         if ((ret = fetch_word(Y++, wordsp++)) != 0)
             return ret;
@@ -2588,6 +3575,15 @@ static int store_yblock(uint addr, int aligned, int n, const t_uint64 *wordsp)
     int ret;
     uint Y = (aligned) ? (addr / n) * n : addr;
 
+    addr_modes_t mode = get_addr_mode();
+    if (mode == APPEND_mode)
+        return store_appended_block(Y, n, wordsp);
+    if (mode == ABSOLUTE_mode && mem_direct_ok(Y, Y + n - 1)) {
+        memcpy(&Mem[Y], wordsp, n * sizeof(*wordsp));
+        mem_stored(Y, Y + n - 1);
+        return 0;
+    }
+
     for (int i = 0; i < n; ++i)
         if ((ret = store_word(Y++, *wordsp++)) != 0)
             return ret;
@@ -2648,8 +3644,67 @@ void word2instr(t_uint64 word, instr_t *ip)
 
 void decode_instr(t_uint64 word)
 {
-    const char* moi = "CU::decode";
     word2instr(word, &cu.IR);
+    decode_setup();
+}
+
+//=============================================================================
+
+/*
+ * decode_instr_abs()
+ *
+ * Same as decode_instr(), but for an instruction word just fetched from
+ * the given absolute address.  Uses the predecode cache.
+ * 
+ */
+
+static void decode_instr_abs(t_uint64 word, uint addr)
+{
+    predecode_t *pp = &predecode[addr & MASKBITS(PREDECODE_BITS)];
+    if (pp->tag != addr + 1) {
+        word2instr(word, &pp->instr);
+        pp->tag = addr + 1;
+        mem_attr[addr >> MEM_ATTR_PAGE_BITS] |= MEM_ATTR_CODE;
+    }
+    cu.IR = pp->instr;
+    decode_setup();
+}
+
+//=============================================================================
+
+/*
+ * predecode_flush()
+ *
+ * Empty the predecode cache (and the block cache built from the same
+ * words).  Needed after writing directly to Mem[] or after changing the
+ * is_eis[] table.
+ * 
+ */
+
+static void predecode_flush(void)
+{
+    memset(predecode, 0, sizeof(predecode));
+    for (uint page = 0; page < ARRAY_SIZE(mem_attr); ++page)
+        mem_attr[page] &= ~ MEM_ATTR_CODE;
+    if (cpu.IC_abs < MAXMEMSIZE)
+        mem_attr[cpu.IC_abs >> MEM_ATTR_PAGE_BITS] |= MEM_ATTR_CODE;
+#if FEAT_BLOCK_CACHE
+    cpu_block_flush();
+#endif
+}
+
+//=============================================================================
+
+/*
+ * decode_setup()
+ *
+ * Initial address movement for the instruction just loaded into cu.IR.
+ * 
+ */
+
+static void decode_setup(void)
+{
+    const char* moi = "CU::decode";
     // Note that the CU doesn't do the bit 29 handling; that's done by the APU.
     TPR.CA = cu.IR.addr;
     TPR.is_value = 0;
@@ -2677,6 +3732,195 @@ void decode_instr(t_uint64 word)
     }
 }
 
+#if FEAT_BLOCK_CACHE
+
+//=============================================================================
+
+/*
+ * cpu_block_flush()
+ *
+ * Discard all cached blocks.  Called when the address translation state
+ * changes (DSBR, SDWAM, PTWAM) and when a word of a cached block is
+ * overwritten.
+ * 
+ */
+
+void cpu_block_flush(void)
+{
+    if (++ block_gen == 0) {
+        memset(blocks, 0, sizeof(blocks));
+        block_gen = 1;
+    }
+    memset(block_code_map, 0, sizeof(block_code_map));
+    ++ block_stats.flushes;
+}
+
+//=============================================================================
+
+/*
+ * block_lookup()
+ *
+ * Find the cached block starting at the current PPR.PSR|IC, if any.
+ * 
+ */
+
+static block_t* block_lookup(void)
+{
+    block_t *bp = &blocks[(PPR.IC ^ (PPR.PSR << 4)) & MASKBITS(BLOCK_BITS)];
+    if (bp->gen == block_gen && bp->ic == PPR.IC && bp->psr == PPR.PSR && bp->prr == PPR.PRR && bp->mode == get_addr_mode())
+        return bp;
+    return NULL;
+}
+
+//=============================================================================
+
+/*
+ * block_build()
+ *
+ * Build a block for the current PPR.PSR|IC.  Called after a successful
+ * instruction fetch; abs is the absolute address of the instruction at
+ * PPR.IC.
+ * 
+ */
+
+static void block_build(uint abs)
+{
+    addr_modes_t mode = get_addr_mode();
+    if (mode == BAR_mode)
+        return;
+
+    block_t *bp = &blocks[(PPR.IC ^ (PPR.PSR << 4)) & MASKBITS(BLOCK_BITS)];
+    bp->gen = block_gen;
+    bp->ic = PPR.IC;
+    bp->psr = PPR.PSR;
+    bp->prr = PPR.PRR;
+    bp->mode = mode;
+    bp->abs = abs;
+    bp->succ[0] = bp->succ[1] = NULL;
+
+    uint max = BLOCK_MAX - PPR.IC % BLOCK_MAX;
+    uint n;
+    for (n = 0; n < max && abs + n < MAXMEMSIZE; ++n) {
+#if FEAT_MEM_CHECK_UNINIT
+        if (! MEM_IS_WRITTEN(abs + n))
+            break;      // leave it to fetch_abs_word() to complain
+#endif
+        word2instr(Mem[abs + n], &bp->instr[n]);
+        if (block_stop[bp->instr[n].opcode])
+            break;
+    }
+    bp->n = n;
+    if (n != 0)
+        mem_attr[abs >> MEM_ATTR_PAGE_BITS] |= MEM_ATTR_CODE;
+    ++ block_stats.built;
+    for (uint a = abs; a < abs + n; a += BLOCK_MAX - a % BLOCK_MAX)
+        block_code_map[a / BLOCK_MAX / 8] |= 1 << (a / BLOCK_MAX % 8);
+}
+
+//=============================================================================
+
+/*
+ * block_run()
+ *
+ * Execute cached blocks starting with the given one, chaining to
+ * successor blocks until something needs the attention of the regular
+ * control unit cycles: a fault, a pending event at a pair boundary, a
+ * missing successor, or the end of the current SIMH time slice.
+ *
+ * This is the fast path for the straight-line, non-repeat, non-XED case
+ * of the EXEC cycle.  The CU state is left as the FETCH and EXEC cycles
+ * would have left it.
+ *
+ * Returns the number of instructions executed.
+ */
+
+static int block_run(block_t* bp)
+{
+    int ran = 0;
+
+    while (bp != NULL) {
+        int taken = 0;
+        ++ block_stats.entered;
+        for (uint i = 0; i < bp->n; ++i) {
+            if (ran) {
+                // Charge the cycles the FETCH and EXEC cycles would have used
+                ++ sys_stats.total_cycles;
+                -- sim_interval;
+                if (PPR.IC % 2 == 0) {
+                    ++ sys_stats.total_cycles;
+                    -- sim_interval;
+                }
+            }
+            ++ ran;
+            ++ block_stats.ninstr;
+            cpu.cycle = EXEC_cycle;
+            cpu.ic_odd = PPR.IC % 2;
+            TPR.TSR = PPR.PSR;
+            TPR.TRR = PPR.PRR;
+            cu.IR = bp->instr[i];
+            decode_setup();
+            int IC_temp = PPR.IC;
+            ic_history_add();
+            execute_ir();
+
+            if (events.any && events.low_group && events.low_group < 7) {
+                log_msg(WARN_MSG, "CU", "Fault detected after instruction execution\n");
+                if (PPR.IC != IC_temp) {
+                    log_msg(INFO_MSG, "CU", "Restoring IC to %06o (from %06o)\n",
+                        IC_temp, PPR.IC);
+                    PPR.IC = IC_temp;
+                }
+                return ran;
+            }
+            if (cpu.cycle != EXEC_cycle)
+                return ran;
+            if (cpu.trgo) {
+                taken = 1;
+                break;
+            }
+            if (PPR.IC != IC_temp) {
+                cpu.cycle = FETCH_cycle;
+                return ran;
+            }
+            ++ PPR.IC;
+            if (cancel || bp->gen != block_gen || (PPR.IC % 2 == 0 && (events.any || sim_interval <= 0)))
+                break;
+        }
+        cpu.cycle = FETCH_cycle;
+        if (! taken && PPR.IC % 2 == 1) {
+            // Stopped in the middle of a pair.  Leave the odd instruction
+            // buffered as if the even one had been run by the EXEC cycle.
+            uint abs = bp->abs + (PPR.IC - bp->ic);
+#if FEAT_MEM_CHECK_UNINIT
+            if (! MEM_IS_WRITTEN(abs))
+                return ran;
+#endif
+            cu.IRODD = Mem[abs];
+            cpu.IC_abs = abs;
+            cpu.irodd_invalid = 0;
+            cpu.ic_odd = 1;
+            cpu.cycle = EXEC_cycle;
+            return ran;
+        }
+        if (cancel || events.any || sim_interval <= 0 || bp->gen != block_gen)
+            return ran;
+        // Chain to the next block
+        block_t *next = bp->succ[taken];
+        if (next == NULL || next->gen != block_gen || next->ic != PPR.IC || next->psr != PPR.PSR || next->prr != PPR.PRR || next->mode != get_addr_mode()) {
+            if ((next = block_lookup()) == NULL)
+                return ran;
+            bp->succ[taken] = next;
+        } else
+            ++ block_stats.chained;
+        if (next->n == 0)
+            return ran;
+        bp = next;
+    }
+    return ran;
+}
+
+#endif
+
 //=============================================================================
 
 /*
@@ -2778,7 +4022,8 @@ static t_stat cpu_dep (t_value v, t_addr simh_addr, UNIT *uptr, int32 switches)
  * init_opcodes()
  *
  * This initializes the is_eis[] array which we use to detect whether or
- * not an instruction is an EIS instruction. 
+ * not an instruction is an EIS instruction.  The list of EIS multiword
+ * instructions lives in the OPU's dispatch table; see opu_init_dispatch().
  *
  * TODO: Change the array values to show how many operand words are
  * used.  This would allow for better symbolic disassembly.
@@ -2788,76 +4033,116 @@ static t_stat cpu_dep (t_value v, t_addr simh_addr, UNIT *uptr, int32 switches)
 
 static void init_opcodes()
 {
-    memset(is_eis, 0, sizeof(is_eis));
-
-    is_eis[(opcode1_cmpc<<1)|1] = 1;
-    is_eis[(opcode1_scd<<1)|1] = 1;
-    is_eis[(opcode1_scdr<<1)|1] = 1;
-    is_eis[(opcode1_scm<<1)|1] = 1;
-    is_eis[(opcode1_scmr<<1)|1] = 1;
-    is_eis[(opcode1_tct<<1)|1] = 1;
-    is_eis[(opcode1_tctr<<1)|1] = 1;
-    is_eis[(opcode1_mlr<<1)|1] = 1;
-    is_eis[(opcode1_mrl<<1)|1] = 1;
-    is_eis[(opcode1_mve<<1)|1] = 1;
-    is_eis[(opcode1_mvt<<1)|1] = 1;
-    is_eis[(opcode1_cmpn<<1)|1] = 1;
-    is_eis[(opcode1_mvn<<1)|1] = 1;
-    is_eis[(opcode1_mvne<<1)|1] = 1;
-    is_eis[(opcode1_csl<<1)|1] = 1;
-    is_eis[(opcode1_csr<<1)|1] = 1;
-    is_eis[(opcode1_cmpb<<1)|1] = 1;
-    is_eis[(opcode1_sztl<<1)|1] = 1;
-    is_eis[(opcode1_sztr<<1)|1] = 1;
-    is_eis[(opcode1_btd<<1)|1] = 1;
-    is_eis[(opcode1_dtb<<1)|1] = 1;
-    is_eis[(opcode1_dv3d<<1)|1] = 1;
+    opu_init_dispatch();
+    for (int i = 0; i < 1024; ++i)
+        is_eis[i] = opu_is_eis_multiword(i);
+#if FEAT_BLOCK_CACHE
+    // Instructions that need the full EXEC cycle handling end a block
+    for (int i = 0; i < 1024; ++i)
+        block_stop[i] = is_eis[i] || opcodes2text[i] == NULL;
+    block_stop[opcode0_xec << 1] = 1;
+    block_stop[opcode0_xed << 1] = 1;
+    block_stop[opcode0_rpt << 1] = 1;
+    block_stop[opcode0_rpd << 1] = 1;
+    block_stop[opcode0_rpl << 1] = 1;
+    block_stop[opcode0_rcu << 1] = 1;
+    block_stop[opcode0_dis << 1] = 1;
+#endif
+    predecode_flush();
 }
 
 // ============================================================================
 
-static int write72(FILE* fp, t_uint64 word0, t_uint64 word1)
+/*
+ * pack72()
+ * unpack72()
+ *
+ * Convert between pairs of 36-bit words and the packed 72-bit form used by
+ * memory images: nine bytes per pair, most significant bits first.  The
+ * loops have no branches, so the compiler is free to unroll or vectorize
+ * them.
+ */
+
+static void pack72(const t_uint64 *wordsp, uint npairs, unsigned char *bufp)
 {
-    for (int i = 0; i < 4; ++i) {
-        unsigned char c;
-        c = (word0 >> (36 - 8 - i * 8)) & 0xff;
-        if (fputc(c, fp) == EOF)
-            return 1;
+    for (uint i = 0; i < npairs; ++i, wordsp += 2, bufp += 9) {
+        t_uint64 hi = ((wordsp[0] & MASK36) << 4) | ((wordsp[1] & MASK36) >> 32);   // 40 bits
+        uint32 lo = (uint32) wordsp[1];
+        bufp[0] = hi >> 32;
+        bufp[1] = hi >> 24;
+        bufp[2] = hi >> 16;
+        bufp[3] = hi >> 8;
+        bufp[4] = hi;
+        bufp[5] = lo >> 24;
+        bufp[6] = lo >> 16;
+        bufp[7] = lo >> 8;
+        bufp[8] = lo;
     }
-    word1 |= (word0 & 0xf) << 36;
-    for (int i = 0; i < 5; ++i) {
-        unsigned char c;
-        c = (word1 >> ((4-i) * 8)) & 0xff;
-        if (fputc(c, fp) == EOF)
-            return 1;
+}
+
+void unpack72(const unsigned char *bufp, uint npairs, t_uint64 *wordsp)
+{
+    for (uint i = 0; i < npairs; ++i, wordsp += 2, bufp += 9) {
+        t_uint64 hi = ((t_uint64) bufp[0] << 32) | ((t_uint64) bufp[1] << 24)
+            | ((t_uint64) bufp[2] << 16) | ((t_uint64) bufp[3] << 8) | bufp[4];
+        t_uint64 lo = ((t_uint64) bufp[5] << 24) | ((t_uint64) bufp[6] << 16)
+            | ((t_uint64) bufp[7] << 8) | bufp[8];
+        wordsp[0] = hi >> 4;
+        wordsp[1] = ((hi & 0xf) << 32) | lo;
     }
-    return 0;
 }
 
-//=============================================================================
+/*
+ * unpack_words()
+ * pack_words()
+ *
+ * Like unpack72() and pack72(), but for n words starting at word number
+ * first of the packed data, which may be the second word of a pair.  A
+ * pair that is only partly stored keeps the other word's bits.  Used for
+ * tape records and disk images.
+ */
+
+void unpack_words(const unsigned char *bufp, t_uint64 first, uint n, t_uint64 *wordsp)
+{
+    const unsigned char *p = bufp + first / 2 * 9;
+    if (n != 0 && first % 2 != 0) {
+        *wordsp++ = ((t_uint64) (p[4] & 0xf) << 32) | ((uint32) p[5] << 24)
+            | ((uint32) p[6] << 16) | ((uint32) p[7] << 8) | p[8];
+        p += 9;
+        --n;
+    }
+    unpack72(p, n / 2, wordsp);
+    if (n % 2 != 0) {
+        p += n / 2 * 9;
+        t_uint64 hi = ((t_uint64) p[0] << 32) | ((uint32) p[1] << 24)
+            | ((uint32) p[2] << 16) | ((uint32) p[3] << 8) | p[4];
+        wordsp[n - 1] = hi >> 4;
+    }
+}
 
-static int read72(FILE* fp, t_uint64* word0p, t_uint64* word1p)
+void pack_words(const t_uint64 *wordsp, uint n, unsigned char *bufp, t_uint64 first)
 {
-    unsigned char buf[9];
-    memset(buf, 0, sizeof(buf));
-    unsigned nread = fread(buf, 1, sizeof(buf), fp);
-    if (nread == 0)
-        return 0;   // caller should test for feof() and ferror()
-    *word0p = 0;
-    for (int i = 0; i < 4; ++i) {
-        *word0p <<= 8;
-        *word0p |= buf[i];
+    unsigned char *p = bufp + first / 2 * 9;
+    if (n != 0 && first % 2 != 0) {
+        t_uint64 word = *wordsp++ & MASK36;
+        p[4] = (p[4] & 0xf0) | (word >> 32);
+        p[5] = word >> 24;
+        p[6] = word >> 16;
+        p[7] = word >> 8;
+        p[8] = word;
+        p += 9;
+        --n;
     }
-    *word0p <<= 4;
-    *word0p |= buf[4] >> 4;
-    if (nread < 5)
-        return 1;   // read less than 36 bits, don't stomp 2nd word
-    *word1p = buf[4] & 0xf;
-    for (int i = 5; i < 9; ++i) {
-        *word1p <<= 8;
-        *word1p |= buf[i];
+    pack72(wordsp, n / 2, p);
+    if (n % 2 != 0) {
+        p += n / 2 * 9;
+        t_uint64 word = wordsp[n - 1] & MASK36;
+        p[0] = word >> 28;
+        p[1] = word >> 20;
+        p[2] = word >> 12;
+        p[3] = word >> 4;
+        p[4] = (p[4] & 0x0f) | ((word & 0xf) << 4);
     }
-    return (nread == 9) ? 0 : 1;
 }
 
 //=============================================================================
@@ -2904,6 +4189,44 @@ static int cpu_set_fault_base(UNIT *uptr, int32 val, char *cptr, void *desc)
 
 //=============================================================================
 
+static int cpu_show_block_cache(FILE *st, UNIT *uptr, int32 val, void *desc)
+{
+    // FIXME: use FILE *st
+
+#if FEAT_BLOCK_CACHE
+    out_msg("Block cache: %s\n", sys_opts.block_cache ? "on" : "off");
+    out_msg("Blocks built: %llu; flushes: %llu\n", block_stats.built, block_stats.flushes);
+    out_msg("Blocks entered: %llu (%llu via chaining)\n", block_stats.entered, block_stats.chained);
+    out_msg("Instructions executed from blocks: %llu", block_stats.ninstr);
+    if (sys_stats.total_instr != 0)
+        out_msg(" (%.1f%%)", 100.0 * block_stats.ninstr / sys_stats.total_instr);
+    out_msg("\n");
+#else
+    out_msg("Block cache: unavailable; compiled without FEAT_BLOCK_CACHE\n");
+#endif
+    return 0;
+}
+
+//=============================================================================
+
+static int cpu_set_block_cache(UNIT *uptr, int32 val, char *cptr, void *desc)
+{
+    if (cptr != NULL) {
+        out_msg("Error, usage is set cpu { BLOCKCACHE | NOBLOCKCACHE }\n");
+        return SCPE_ARG;
+    }
+#if ! FEAT_BLOCK_CACHE
+    if (val) {
+        out_msg("Error, compiled without FEAT_BLOCK_CACHE\n");
+        return SCPE_ARG;
+    }
+#endif
+    sys_opts.block_cache = val;
+    return 0;
+}
+
+//=============================================================================
+
 static int cpu_show_model(FILE *st, UNIT *uptr, int32 val, void *desc)
 {
     // FIXME: use FILE *st
@@ -13,11 +13,13 @@
 #include "hw6180.h"
 #include "seginfo.hpp"
 #include <ctype.h>
+#include <sys/mman.h>
 
 
 // The following are assigned to SIMH function pointers
 static t_addr parse_addr(DEVICE *dptr, char *cptr, char **optr);
 static void hw6180_init(void);
+static void* mem_alloc(size_t nbytes, int huge);
 
 extern DEVICE cpu_dev;
 extern DEVICE tape_dev;
@@ -82,6 +84,7 @@ static struct sim_ctab sim_cmds[] =  {
     { "XLIST",    cmd_load_listing, 0, "xlist <addr> <source>            load pl1 listing\n" },
     { "XSYMTAB",  cmd_symtab_parse, 0, "xsymtab {help|dump|...}          manipulate symtab entries\n" },
     { "XSTATS",   cmd_stats, 0,        "xstats                           display statistics\n" },
+    { "XWATCH",   cmd_watch, 0,        "xwatch [list|add <lo> [<hi>]|del <lo>]  log accesses to absolute memory\n" },
 #if 0
     // replaced by "show" modifiers
     { "XHISTORY", cmd_dump_history, 0, "xhistory                         display recent instruction counter values\n" },
@@ -163,6 +166,7 @@ static void hw6180_init(void)
     sys_opts.mt_times.read = 3; // -1; 100; 1000;
     sys_opts.mt_times.xfer = -1;            // unimplemented
     sys_opts.warn_uninit = 1;
+    sys_opts.block_cache = 1;
     sys_opts.startup_interrupt = 1;
 
 
@@ -218,16 +222,20 @@ static void hw6180_init(void)
     // Only one IOM
     iom.iom_num = 0;    // IOM "A"
 
-    Mem = malloc(sizeof(*Mem) * MAXMEMSIZE);
+    // Pages of memory are only committed by the host when first touched
+    Mem = mem_alloc(sizeof(*Mem) * MAXMEMSIZE, FEAT_MEM_HUGEPAGES);
     if (Mem == NULL) {
         log_msg(ERR_MSG, "SYS::init", "Cannot allocate memory.\n");
         return;
     }
 #if FEAT_MEM_CHECK_UNINIT
-    memset(Mem, 0xff, MAXMEMSIZE*sizeof(Mem[0]));
-#else
-    memset(Mem, 0, MAXMEMSIZE*sizeof(Mem[0]));
+    Mem_written = mem_alloc(MAXMEMSIZE / 8, 0);
+    if (Mem_written == NULL) {
+        log_msg(ERR_MSG, "SYS::init", "Cannot allocate memory.\n");
+        return;
+    }
 #endif
+    mem_attr_init();
 
     // CPU port 'a' connected to port '5' of SCU
     // scas_init's call to make_card seems to require that the CPU be connected
@@ -284,6 +292,32 @@ static void hw6180_init(void)
     log_msg(INFO_MSG, "SYS::init", "Activity queue has %d entries.\n", sim_qcount());
 }
 
+//=============================================================================
+
+/*
+ * mem_alloc()
+ *
+ * Allocate zeroed memory that the host only commits as pages are touched.
+ * Optionally ask for transparent huge pages.
+ */
+
+static void* mem_alloc(size_t nbytes, int huge)
+{
+    void *p = mmap(NULL, nbytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (p == MAP_FAILED) {
+        log_msg(WARN_MSG, "SYS::init", "Cannot mmap %lu bytes: %s; using calloc() instead.\n", (unsigned long) nbytes, strerror(errno));
+        return calloc(1, nbytes);
+    }
+#ifdef MADV_HUGEPAGE
+    if (huge && madvise(p, nbytes, MADV_HUGEPAGE) != 0)
+        log_msg(NOTIFY_MSG, "SYS::init", "Transparent huge pages unavailable: %s\n", strerror(errno));
+#else
+    if (huge)
+        log_msg(NOTIFY_MSG, "SYS::init", "Transparent huge pages unavailable on this host\n");
+#endif
+    return p;
+}
+
 
 //=============================================================================
 
@@ -347,23 +381,17 @@ t_stat fprint_sym (FILE *ofile, t_addr simh_addr, t_value *val, UNIT *uptr, int3
         t_addr ahi = abs_addr;
         t_uint64 word;
         word = Mem[abs_addr];
-        if (word == ~ (t_uint64) 0)
-            word = 0;
         fprintf(ofile, "%012llo", word);
         if (sw & SWMASK('S') || (sw & SWMASK('X'))) {
             // SDWs are two words
             ++ ahi;
             t_uint64 hiword = Mem[ahi];
-            if (hiword == ~ (t_uint64) 0)
-                hiword = 0;
             fprintf(ofile, " %012llo", hiword);
         }
         /* User may request (A)scii in addition to another format */
         if (sw & SWMASK('A')) {
             for (t_addr a = alow; a <= ahi; ++ a) {
                 t_uint64 word = Mem[a];
-                if (word == ~ (t_uint64) 0)
-                    word = 0;
                 fprintf(ofile, " ");
                 for (int i = 0; i < 4; ++i) {
                     uint c = word >> 27;
@@ -395,8 +423,6 @@ t_stat fprint_sym (FILE *ofile, t_addr simh_addr, t_value *val, UNIT *uptr, int3
         } else if (sw & SWMASK('S') || (sw & SWMASK('X'))) {
             // S/X -> SDW
             t_uint64 hiword = Mem[ahi];
-            if (hiword == ~ (t_uint64) 0)
-                hiword = 0;
             char *s = print_sdw(word, hiword);
             fprintf(ofile, " %s", s);
         } else if (sw & SWMASK('W')) {
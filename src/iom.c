@@ -762,16 +762,8 @@ static int run_channel(int chan)
         } else if (chanp->control == 0 && ! first_list) {
             int is_idle;
             if (chanp->xfer_running) {
-                if (iom.channels[chan].type != DEVT_DISK) {
-                    is_idle = 0;
-                    log_msg(INFO_MSG, moi, "Channel %d almost out of work, but non-DISK channels get another list svc for in-progress transfers.\n", chan);
-                } else {
-                    // BUG: This is wierd...
-                    is_idle = 1;
-                    log_msg(NOTIFY_MSG, moi, "Channel %d shows transfer in progress, but it's a disk channel, so it's deemed out of work.\n", chan);
-                    cancel_run(STOP_IBKPT);
-                    (void) iom_show_chan_mbx(NULL, chan);
-                }
+                is_idle = 0;
+                log_msg(INFO_MSG, moi, "Channel %d almost out of work, but gets another list svc for an in-progress transfer.\n", chan);
             } else
                 is_idle = 1;
             if (is_idle) {
@@ -858,11 +850,8 @@ static int run_channel(int chan)
     
         int need_ls = chanp->control == 2 || first_list;
         if (! need_ls && chanp->xfer_running) {
-            if (iom.channels[chan].type != DEVT_DISK) {
-                log_msg(INFO_MSG, moi, "Doing a list service due to in-progess transfer on a non-DISK channel.\n");
-                need_ls = 1;
-            } else
-                log_msg(INFO_MSG, moi, "Not doing a list service in spite of an in-progess transfer for a DISK channel.\n");
+            log_msg(INFO_MSG, moi, "Doing a list service due to in-progess transfer.\n");
+            need_ls = 1;
         }
         if (need_ls) {
             // Do a list service
@@ -1497,9 +1486,9 @@ static int dev_io(int chan, t_uint64 *wordp)
             return ret; // caller must choose between our return and the status.{major,substatus}
         }
         case DEVT_DISK: {
-            ret = disk_iom_io(chan, wordp, &chanp->status.major, &chanp->status.substatus);
-            // TODO: uncomment & switch to DEBUG: if (ret != 0 || chanp->status.major != 0)
-                log_msg(INFO_MSG, "IOM::dev-io", "DISK returns major code 0%o substatus 0%o\n", chanp->status.major, chanp->status.substatus);
+            ret = disk_iom_io(devinfop, wordp);
+            if (ret != 0 || devinfop->major != 0)
+                log_msg(DEBUG_MSG, "IOM::dev-io", "DISK returns major code 0%o substatus 0%o\n", devinfop->major, devinfop->substatus);
             break;
         }
         default:
@@ -1528,6 +1517,58 @@ static int dev_io(int chan, t_uint64 *wordp)
 
 // ============================================================================
 
+/*
+ * dev_io_block()
+ *
+ * Block form of dev_io().  Hands a device up to n words at wordsp, normally
+ * the DCW's span of main memory, and lets it fill or drain them in one
+ * call.  The number of words moved is returned via countp and status is
+ * copied to the channel once, at the end.  *to_memp is set if the device
+ * stored into wordsp rather than only reading it.  Returns -1 without doing
+ * anything if the device only supports single word transfers.
+ */
+
+static int dev_io_block(int chan, t_uint64 *wordsp, uint n, uint *countp, int *to_memp)
+{
+    *countp = 0;
+    *to_memp = 1;
+    channel_t* chanp = get_chan(chan);
+    if (chanp == NULL || iom.channels[chan].dev == NULL)
+        return -1;      // let dev_io() report it
+
+    chan_devinfo *devinfop = chanp->devinfop;
+    int ret;
+    switch(iom.channels[chan].type) {
+        case DEVT_TAPE:
+            if (devinfop == NULL)
+                return -1;
+            chanp->status.power_off = 0;
+            ret = mt_iom_io_block(devinfop, wordsp, n, countp);
+            break;
+        case DEVT_DISK:
+            if (devinfop == NULL)
+                return -1;
+            chanp->status.power_off = 0;
+            ret = disk_iom_io_block(devinfop, wordsp, n, countp);
+            *to_memp = devinfop->is_read;
+            break;
+        default:
+            // Console I/O is interactive
+            return -1;
+    }
+
+    if (devinfop->have_status) {
+        chanp->have_status = devinfop->have_status;
+        chanp->status.major = devinfop->major;
+        chanp->status.substatus = devinfop->substatus;
+    }
+    if (ret != 0 || chanp->status.major != 0)
+        log_msg(DEBUG_MSG, "IOM::dev-io", "Block transfer of %u words returns major code 0%o substatus 0%o after %u words\n", n, chanp->status.major, chanp->status.substatus, *countp);
+    return ret;
+}
+
+// ============================================================================
+
 /*
  * do_ddcw()
  *
@@ -1566,23 +1607,50 @@ static int do_ddcw(int chan, int addr, dcw_t *dcwp, int *control)
         log_msg(INFO_MSG, "IOM::DDCW", "I/O Request(s) starting at addr 0%o; tally = zero->%d\n", daddr, tally);
     } else
         log_msg(INFO_MSG, "IOM::DDCW", "I/O Request(s) starting at addr 0%o; tally = %d\n", daddr, tally);
-    int ret;
+    int ret = -1;
+    if (type != 3 && daddr + tally <= MAXMEMSIZE) {
+        // Try to move the whole span at once.  Devices use memory in place
+        // unless some page needs the checks in store_abs_word().
+        static t_uint64 bounce[4096];
+        int direct = mem_direct_ok(daddr, daddr + tally - 1);
+        t_uint64 *wordsp = (direct) ? &Mem[daddr] : bounce;
+        if (! direct)
+            memcpy(bounce, &Mem[daddr], tally * sizeof(*bounce));
+        uint n;
+        int to_mem;
+        ret = dev_io_block(chan, wordsp, tally, &n, &to_mem);
+        if (ret >= 0 && to_mem) {
+            if (direct) {
+                if (n != 0)
+                    mem_stored(daddr, daddr + n - 1);
+            } else
+                for (uint i = 0; i < n; ++i)
+                    (void) store_abs_word(daddr + i, bounce[i]);
+        }
+        if (ret >= 0) {
+            if (ret != 0)
+                log_msg(DEBUG_MSG, "IOM::DDCW", "Device for chan 0%o(%d) returns non zero (out of band return)\n", chan, chan);
+            daddr += n;
+            tally -= n;
+        }
+    }
     t_uint64 buf = 0;
     t_uint64 temp = 0;
-    for (;;) {
+    int is_read = chanp->devinfop != NULL && chanp->devinfop->is_read;
+    // Otherwise, one word at a time
+    if (ret < 0) for (;;) {
         if (type != 3) {
             buf = Mem[daddr];
             temp = buf;
-            if (buf == ~ (t_uint64) 0)
-                buf = 0;
         }
         ret = dev_io(chan, &buf);
         // For now, let dev_io() and children tell us if we should stroe the
         // any transferred data.  However, we should really validate that the
         // we can instead base the decision on the return status.  The current
         // comparison fails to trigger breakpoints when the new value is a rewrite
-        // of the prior value.
-        if (type != 3 && buf != temp)
+        // of the prior value.  Words read from a device are always stored, so
+        // that zeros land in demand-zero memory as written.
+        if (type != 3 && (is_read || buf != temp))
             (void) store_abs_word(daddr, buf);
         if (ret != 0)
             log_msg(DEBUG_MSG, "IOM::DDCW", "Device for chan 0%o(%d) returns non zero (out of band return)\n", chan, chan);
@@ -1,5 +1,6 @@
 /*
-    math.c -- math routines.   Implemented via GNU MP library.
+    math.c -- math routines.   Implemented via 128-bit integers, or via
+    the GNU MP library if FEAT_MATH_GMP is set.
 */
 /*
    Copyright (c) 2007-2013 Michael Mondy
@@ -12,6 +13,164 @@
 
 #include "hw6180.h"
 #include <limits.h>
+
+#if ! FEAT_MATH_GMP
+
+// All operands fit in 72 bits and no product exceeds 110 bits, so native
+// 128-bit integers suffice.  The GMP versions below remain the reference;
+// the results here match them bit for bit, including how they pick which
+// 36-bit "limbs" of a result to return.
+
+__extension__ typedef unsigned __int128 uint128;
+
+/*
+ * nlimbs36()
+ *
+ * Number of 36-bit limbs needed to hold v; zero if v is zero.
+ */
+
+static inline int nlimbs36(uint128 v)
+{
+    int n = 0;
+    for (; v != 0; v >>= 36)
+        ++n;
+    return n;
+}
+
+/*
+ * limb36()
+ *
+ * Returns the n'th 36-bit limb of v, counting from the least significant.
+ */
+
+static inline t_uint64 limb36(uint128 v, int n)
+{
+    return (t_uint64) (v >> (36 * n)) & MASK36;
+}
+
+//=============================================================================
+
+void mpy(t_uint64 a, t_uint64 b, t_uint64* hip, t_uint64 *lowp)
+{
+    // Signed multiply of two 36bit integers, a and b, with results
+    // into *hip and *lowp.  If desired, it's safe for hip and/or lowp
+    // to point to a and/or b.
+
+    flag_t neg = 0;
+    flag_t maxneg = 0;
+    if (a == 0) {
+        if (b == 0) {
+            *lowp = 0;
+            *hip = 0;
+            return;
+        }
+    } else if (bit36_is_neg(a)) {
+        maxneg = a == - ((t_int64)1<<35);
+        a = -a; // result will be 35 or less bits
+        neg = 1;
+    }
+    if (bit36_is_neg(b)) {
+        maxneg &= b == - ((t_int64)1<<35);
+        if (maxneg) {
+            *lowp = 0;
+            *hip = (t_uint64)1 << 34;       
+            return;
+        }
+        b = -b; // result will be 35 or less bits
+        neg = !neg;
+    }
+
+    uint128 prod = (uint128) a * b;
+    t_uint64 hi = limb36(prod, 1);
+    t_uint64 low = limb36(prod, 0);
+
+    if (neg) {
+        hi = (~hi) & MASK36;
+        if (low == 0)
+            ++hi;       // complement of zero, then plus one yields low of zero with carry into hi
+        else
+            low = ((~low) + 1) & MASK36;    // no carry possible
+    }
+    *lowp = low;
+    *hip = hi;
+}
+
+//=============================================================================
+
+void mpy72fract(t_uint64 ahi, t_uint64 alow, t_uint64 b, t_uint64* hip, t_uint64 *lowp)
+{
+    // Signed multiply of a 72bit fraction by a 36bit fraction, with results
+    // into *hip and *lowp.  72 MSB bits are returned; excess less significant
+    // bits are discarded.
+    // If desired, it's safe for hip and/or lowp to point to a and/or b.
+
+    // BUG: We may mishandle the max negative value
+    flag_t neg = 0;
+    if (ahi == 0 && alow == 0) {
+        *lowp = 0;
+        *hip = 0;
+        return;
+    } else if (b == 0) {
+        *lowp = 0;
+        *hip = 0;
+        return;
+    } else if (bit36_is_neg(ahi)) {
+        negate72(&ahi, &alow);
+        neg = 1;
+    }
+    if (bit36_is_neg(b)) {
+        b = negate36(b);    // results is 35 bits or less
+        neg = !neg;
+    }
+
+    // We want the first bit to represent 2^-1, not -1*2^0 for the multiply
+    // No need to mask the following because ahi and b are non-negative
+    b <<= 1;
+    ahi <<= 1;
+    ahi |= (alow >> 35);
+    alow = (alow << 1) & MASK36;
+
+    uint128 prod = (((uint128) (ahi & MASK36) << 36) | (alow & MASK36)) * b;
+
+    // Keep the two most significant non-zero limbs
+    int n = nlimbs36(prod);
+    *hip = (n == 0) ? 0 : limb36(prod, n - 1);   // zero for max negative; see BUG above
+    *lowp = (n < 2) ? 0 : limb36(prod, n - 2);
+    // The first bit now represents 2^-1, but the H6180 wants it to be -1*2^0, so shift
+    *lowp >>= 1;
+    if ((*hip & 1) != 0)
+        *lowp |= ((t_uint64)1<<35);
+    *hip >>= 1;
+    // We did a positive multiplication, so negate now if needed
+    if (neg)
+        negate72(hip, lowp);
+}
+
+//=============================================================================
+
+void div72(t_uint64 hi, t_uint64 low, t_uint64 divisor, t_uint64* quotp, t_uint64* remp)
+{
+    // unsigned 72 bit value divided by 36 bit value with remainder
+
+    uint128 num = ((uint128) (hi & MASK36) << 36) | (low & MASK36);
+
+    // No scaling -- scaled 72bit numerator, scaled 36 bit denominator; result
+    // is scaled 36 bit quotient (but may need 72 bits if denominator was one)
+    uint128 quot = num / divisor;
+    uint128 rem = num % divisor;
+
+    // Caller wants only the most significant bits of the quotient
+    int n = nlimbs36(quot);
+    *quotp = (n == 0) ? 0 : limb36(quot, n - 1);
+
+    // We should shift remainder right by 36 bits -- but caller just wants
+    // the lower 36 bits not the more significant 36 zeros
+    n = nlimbs36(rem);
+    *remp = (n == 0) ? 0 : limb36(rem, n - 1);
+}
+
+#else
+
 #include <gmp.h>
 
 static inline void set36u(mpz_t rop, t_uint64 val)
@@ -164,12 +323,13 @@ void mpy72fract(t_uint64 ahi, t_uint64 alow, t_uint64 b, t_uint64* hip, t_uint64
     } else if (b == 0) {
         *lowp = 0;
         *hip = 0;
+        return;
     } else if (bit36_is_neg(ahi)) {
         negate72(&ahi, &alow);
         neg = 1;
     }
     if (bit36_is_neg(b)) {
-        b = -b; // results is 35 bits or less
+        b = negate36(b);    // results is 35 bits or less
         neg = !neg;
     }
 
@@ -197,7 +357,7 @@ void mpy72fract(t_uint64 ahi, t_uint64 alow, t_uint64 b, t_uint64* hip, t_uint64
         *hip = 0;
     } else {
         *hip = bits[0];
-        if (count < 1)
+        if (count < 2)
             *lowp = 0;
         else
             *lowp = bits[1];
@@ -270,3 +430,5 @@ void div72(t_uint64 hi, t_uint64 low, t_uint64 divisor, t_uint64* quotp, t_uint6
     mpz_clear(quot);
     mpz_clear(rem);
 }
+
+#endif  // FEAT_MATH_GMP
@@ -47,9 +47,6 @@
 
     TODO
 
-        Get rid of bitstream; that generality isn't needed since all
-        records seem to be in multiples of 8*9=72 bits.
-
         When simulating timing, switch to queuing the activity instead
         of queueing the status return.   That may allow us to remove most
         of our state variables and more easily support save/restore.
@@ -66,9 +63,10 @@
         activity needs a status service or iom fault.
 */
 
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "hw6180.h"
 #include "sim_tape.h"
-#include "bitstream.h"
 
 extern iom_t iom;
 
@@ -80,14 +78,231 @@ static struct s_tape_state {
     // BUG: An array index by channel doesn't allow multiple tapes per channel
     enum { no_mode, read_mode, write_mode } io_mode;
     uint8 *bufp;
-    bitstream_t *bitsp;
+    const uint8 *datap; // record being transferred; bufp or the tape mapping
+    t_mtrlnt tbc;       // bytes at datap
+    uint nwords;        // 36-bit words already handed to the IOM
 } tape_state[ARRAY_SIZE(iom.channels)];
 
+// A read-only tape image mapped into memory, with an index of its records.
+// Hangs off of the unit's up7.
+struct s_tape_map {
+    const uint8 *base;
+    size_t len;
+    struct s_tape_ent {
+        size_t off;     // file offset of the leading record length
+        size_t next;    // file offset of the following record
+        t_mtrlnt tbc;   // zero for a tape mark
+    } *ents;
+    uint nents;
+    uint cur;           // next record; nents at the end of the tape
+};
+
 void mt_init()
 {
     memset(tape_state, 0, sizeof(tape_state));
 }
 
+// ============================================================================
+
+static t_mtrlnt get_mtrlnt(const uint8 *p)
+{
+    // SIMH writes record lengths little-endian
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((t_mtrlnt) p[3] << 24);
+}
+
+/*
+ * mt_map_index()
+ *
+ * Build the record index of a mapped tape image in one pass.  Reading
+ * stops at an end-of-medium marker or at the end of the file.  Returns
+ * non-zero for anything other than plain records and tape marks, e.g.
+ * records with error flags or gaps; such tapes are left to SIMH.
+ */
+
+static int mt_map_index(struct s_tape_map *mapp)
+{
+    uint cap = 0;
+    size_t off = 0;
+    while (off + sizeof(t_mtrlnt) <= mapp->len) {
+        t_mtrlnt tbc = get_mtrlnt(mapp->base + off);
+        if (tbc == 0xffffffff)
+            break;      // end of medium
+        if ((tbc & 0xff000000) != 0)
+            return 1;
+        size_t next = off + sizeof(t_mtrlnt);
+        if (tbc != 0) {
+            next += ((tbc + 1) & ~1) + sizeof(t_mtrlnt);
+            if (next > mapp->len || get_mtrlnt(mapp->base + next - sizeof(t_mtrlnt)) != tbc)
+                return 1;
+        }
+        if (mapp->nents == cap) {
+            cap = (cap == 0) ? 1024 : 2 * cap;
+            struct s_tape_ent *ents = realloc(mapp->ents, cap * sizeof(*ents));
+            if (ents == NULL)
+                return 1;
+            mapp->ents = ents;
+        }
+        struct s_tape_ent *entp = &mapp->ents[mapp->nents++];
+        entp->off = off;
+        entp->next = next;
+        entp->tbc = tbc;
+        off = next;
+    }
+    return 0;
+}
+
+/*
+ * mt_map_free()
+ */
+
+static void mt_map_free(UNIT *uptr)
+{
+    struct s_tape_map *mapp = uptr->up7;
+    if (mapp == NULL)
+        return;
+    // Don't leave a record being transferred pointing into the mapping
+    for (int i = 0; i < ARRAY_SIZE(tape_state); ++i)
+        if (tape_state[i].datap >= mapp->base && tape_state[i].datap < mapp->base + mapp->len) {
+            tape_state[i].datap = NULL;
+            tape_state[i].tbc = 0;
+        }
+    if (mapp->base != NULL)
+        munmap((void *) mapp->base, mapp->len);
+    free(mapp->ents);
+    free(mapp);
+    uptr->up7 = NULL;
+}
+
+/*
+ * mt_attach()
+ *
+ * Attach routine for the tape device.  Read-only attachments in SIMH's
+ * standard format are also mapped into memory and indexed, so that
+ * reading and spacing don't go through SIMH's stdio based routines.
+ * SIMH still owns the file and the unit position.
+ */
+
+t_stat mt_attach(UNIT *uptr, char *cptr)
+{
+    mt_map_free(uptr);
+    t_stat ret = sim_tape_attach(uptr, cptr);
+    if (ret != SCPE_OK || ! (uptr->flags & UNIT_RO) || MT_GET_FMT(uptr) != MTUF_F_STD)
+        return ret;
+
+    struct s_tape_map *mapp = calloc(1, sizeof(*mapp));
+    struct stat sbuf;
+    if (mapp == NULL || fstat(fileno(uptr->fileref), &sbuf) != 0 || sbuf.st_size == 0) {
+        free(mapp);
+        return SCPE_OK;
+    }
+    void *addr = mmap(NULL, sbuf.st_size, PROT_READ, MAP_SHARED | MAP_NORESERVE, fileno(uptr->fileref), 0);
+    if (addr == MAP_FAILED) {
+        log_msg(WARN_MSG, "MT::attach", "Cannot mmap %s: %s\n", cptr, strerror(errno));
+        free(mapp);
+        return SCPE_OK;
+    }
+    (void) madvise(addr, sbuf.st_size, MADV_SEQUENTIAL);
+    mapp->base = addr;
+    mapp->len = sbuf.st_size;
+    uptr->up7 = mapp;
+    if (mt_map_index(mapp) != 0) {
+        log_msg(NOTIFY_MSG, "MT::attach", "Tape %s has records that SIMH must handle; not indexing it.\n", cptr);
+        mt_map_free(uptr);
+        return SCPE_OK;
+    }
+    log_msg(INFO_MSG, "MT::attach", "Indexed %u records and marks of %s.\n", mapp->nents, cptr);
+    return SCPE_OK;
+}
+
+t_stat mt_detach(UNIT *uptr)
+{
+    mt_map_free(uptr);
+    return sim_tape_detach(uptr);
+}
+
+/*
+ * mt_map_locate()
+ *
+ * Returns the index of a mapped tape with its cursor matching the unit
+ * position, or NULL if the tape isn't mapped or is positioned somewhere
+ * the index doesn't know about.
+ */
+
+static struct s_tape_map *mt_map_locate(UNIT *unitp)
+{
+    struct s_tape_map *mapp = unitp->up7;
+    if (mapp == NULL || ! (unitp->flags & UNIT_ATT))
+        return NULL;
+    size_t end = (mapp->nents == 0) ? 0 : mapp->ents[mapp->nents - 1].next;
+    t_addr pos = unitp->pos;
+    if (mapp->cur < mapp->nents && mapp->ents[mapp->cur].off == pos)
+        return mapp;
+    if (mapp->cur == mapp->nents && pos == end)
+        return mapp;
+    // Moved behind our back, e.g. by a re-attach or a command that isn't
+    // done via the index
+    if (pos >= end) {
+        if (pos != end)
+            return NULL;
+        mapp->cur = mapp->nents;
+        return mapp;
+    }
+    uint lo = 0, hi = mapp->nents;
+    while (lo < hi) {
+        uint mid = lo + (hi - lo) / 2;
+        if (mapp->ents[mid].off < pos)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo == mapp->nents || mapp->ents[lo].off != pos)
+        return NULL;
+    mapp->cur = lo;
+    return mapp;
+}
+
+/*
+ * mt_map_read()
+ *
+ * Index based equivalent of sim_tape_rdrecf().  The record is not copied;
+ * *datapp is set to point into the mapping.
+ */
+
+static int mt_map_read(UNIT *unitp, struct s_tape_map *mapp, const uint8 **datapp, t_mtrlnt *tbcp)
+{
+    *tbcp = 0;
+    if (mapp->cur == mapp->nents)
+        return MTSE_EOM;
+    const struct s_tape_ent *entp = &mapp->ents[mapp->cur++];
+    unitp->pos = entp->next;
+    if (entp->tbc == 0)
+        return MTSE_TMK;
+    *datapp = mapp->base + entp->off + sizeof(t_mtrlnt);
+    *tbcp = entp->tbc;
+    return MTSE_OK;
+}
+
+/*
+ * mt_map_sprecr()
+ *
+ * Index based equivalent of sim_tape_sprecr().
+ */
+
+static int mt_map_sprecr(UNIT *unitp, struct s_tape_map *mapp, t_mtrlnt *tbcp)
+{
+    *tbcp = 0;
+    if (mapp->cur == 0)
+        return MTSE_BOT;
+    const struct s_tape_ent *entp = &mapp->ents[--mapp->cur];
+    unitp->pos = entp->off;
+    if (entp->tbc == 0)
+        return MTSE_TMK;
+    *tbcp = entp->tbc;
+    return MTSE_OK;
+}
+
+// ============================================================================
+
 /*
  * mt_iom_cmd()
  *
@@ -161,22 +376,24 @@ int mt_iom_cmd(chan_devinfo* devinfop)
         case 5: {               // CMD 05 -- Read Binary Record
             // We read the record into the tape controllers memory;
             // IOM can subsequently retrieve the data via DCWs.
-            if (tape_statep->bufp == NULL)
-                if ((tape_statep->bufp = malloc(bufsz)) == NULL) {
-                    log_msg(ERR_MSG, "MT::iom_cmd", "Malloc error\n");
-                    devinfop->have_status = 1;
-                    *majorp = 012;  // BUG: arbitrary error code; config switch
-                    *subp = 1;
-                    return 1;
-                }
+            // A mapped tape image is read in place.
             t_mtrlnt tbc = 0;
             int ret;
-#if 0
-            if (! (unitp->flags & UNIT_ATT))
-                ret = MTSE_UNATT;
-            else
-#endif
+            struct s_tape_map *mapp = mt_map_locate(unitp);
+            if (mapp != NULL)
+                ret = mt_map_read(unitp, mapp, &tape_statep->datap, &tbc);
+            else {
+                if (tape_statep->bufp == NULL)
+                    if ((tape_statep->bufp = malloc(bufsz)) == NULL) {
+                        log_msg(ERR_MSG, "MT::iom_cmd", "Malloc error\n");
+                        devinfop->have_status = 1;
+                        *majorp = 012;  // BUG: arbitrary error code; config switch
+                        *subp = 1;
+                        return 1;
+                    }
                 ret = sim_tape_rdrecf(unitp, tape_statep->bufp, &tbc, bufsz);
+                tape_statep->datap = tape_statep->bufp;
+            }
             if (ret != 0) {
                 if (ret == MTSE_TMK || ret == MTSE_EOM) {
                     log_msg(NOTIFY_MSG, "MT::iom_cmd", "EOF: %s\n", simh_tape_msg(ret));
@@ -197,7 +414,8 @@ int mt_iom_cmd(chan_devinfo* devinfop)
                     return 1;
                 }
             }
-            tape_statep->bitsp = bitstm_new(tape_statep->bufp, tbc);
+            tape_statep->tbc = tbc;
+            tape_statep->nwords = 0;
             // note: leaving devinfop->have_status cleared
             *majorp = 0;
             *subp = 0;
@@ -224,7 +442,12 @@ int mt_iom_cmd(chan_devinfo* devinfop)
             // BUG? We don't check the channel data for a count
             t_mtrlnt tbc;
             int ret;
-            if ((ret = sim_tape_sprecr(unitp, &tbc)) == 0) {
+            struct s_tape_map *mapp = mt_map_locate(unitp);
+            if (mapp != NULL)
+                ret = mt_map_sprecr(unitp, mapp, &tbc);
+            else
+                ret = sim_tape_sprecr(unitp, &tbc);
+            if (ret == 0) {
                 log_msg(NOTIFY_MSG, "MT::iom_cmd", "Backspace one record\n");
                 devinfop->have_status = 1;  // TODO: queue
                 *majorp = 0;
@@ -268,9 +491,54 @@ int mt_iom_cmd(chan_devinfo* devinfop)
 
 // ============================================================================
 
+/*
+ * mt_unpack()
+ *
+ * Move up to n 36-bit words from the record buffer, continuing where the
+ * last call stopped.  Any bits left over after the last whole word are
+ * ignored.  Returns the number of words moved.
+ */
+
+static uint mt_unpack(struct s_tape_state *tape_statep, t_uint64 *wordsp, uint n)
+{
+    uint w = tape_statep->nwords;
+    uint avail = (uint) ((tape_statep->tbc * (t_uint64) 8) / 36);
+    if (w >= avail)
+        return 0;
+    if (n > avail - w)
+        n = avail - w;
+    unpack_words(tape_statep->datap, w, n, wordsp);
+    tape_statep->nwords = w + n;
+    return n;
+}
+
+// ============================================================================
+
+/*
+ * mt_iom_io()
+ *
+ * Transfer a single word.  Kept for callers that are not moving a whole
+ * DCW span; see mt_iom_io_block().
+ */
 
 int mt_iom_io(chan_devinfo* devinfop, t_uint64 *wordp)
 {
+    uint n;
+    return mt_iom_io_block(devinfop, wordp, 1, &n);
+}
+
+/*
+ * mt_iom_io_block()
+ *
+ * Transfer up to n words between the tape controller's buffer and wordsp,
+ * which is normally main memory itself.  The number of words moved is
+ * returned via countp, and status is set once for the whole transfer.
+ * Returns non-zero (out of band) if fewer than n words could be moved.
+ */
+
+int mt_iom_io_block(chan_devinfo* devinfop, t_uint64 *wordsp, uint n, uint *countp)
+{
+    *countp = 0;
     int chan = devinfop->chan;
     int* majorp = &devinfop->major;
     int* subp = &devinfop->substatus;
@@ -316,7 +584,8 @@ int mt_iom_io(chan_devinfo* devinfop, t_uint64 *wordp)
         return 1;
     } else if (tape_statep->io_mode == read_mode) {
         // read
-        if (bitstm_get(tape_statep->bitsp, 36, wordp) != 0) {
+        *countp = mt_unpack(tape_statep, wordsp, n);
+        if (*countp < n) {
             // BUG: There isn't another word to be read from the tape buffer,
             // but the IOM wants  another word.
             // BUG: How did this tape hardware handle an attempt to read more
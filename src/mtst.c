@@ -0,0 +1,211 @@
+/*
+   Copyright (c) 2007-2013 Michael Mondy
+
+   This software is made available under the terms of the
+   ICU License -- ICU 1.8.1 and later.
+   See the LICENSE file at the top-level directory of this distribution and
+   at http://example.org/project/LICENSE.
+*/
+
+/*
+    mtst.c -- tests of the math routines in math.c
+
+    The Makefile compiles math.c twice, once with native 128-bit integers
+    and once with GMP (with its entry points renamed to gmp_*), and links
+    both here.  Both versions are checked against known answers, then
+    against each other: exhaustively over edge values and small operands,
+    followed by random operands.  Run via "make check-math".
+
+    usage: mtst [ncases [seed]]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "hw6180.h"
+
+// The GMP build of math.c
+extern void gmp_mpy(t_uint64 a, t_uint64 b, t_uint64* hip, t_uint64 *lowp);
+extern void gmp_div72(t_uint64 hi, t_uint64 low, t_uint64 divisor, t_uint64* quotp, t_uint64* remp);
+extern void gmp_mpy72fract(t_uint64 ahi, t_uint64 alow, t_uint64 b, t_uint64* hip, t_uint64 *lowp);
+
+static int nfail;
+static long nchecked;
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Known answers for mpy72fract().  Operands and results are fractions
+ * with the sign in bit zero, so 0200000000000 is 0.5 and 0600000000000
+ * is -0.5.
+ */
+
+static const struct {
+    t_uint64 ahi, alow, b;
+    t_uint64 hi, low;
+} mpy72fract_cases[] = {
+    // 0.5 * 0.5 = 0.25
+    { 0200000000000, 0, 0200000000000, 0100000000000, 0 },
+    // -0.5 * 0.5 = -0.25
+    { 0600000000000, 0, 0200000000000, 0700000000000, 0 },
+    // A negative multiplier.  The GMP version used to negate it in 64
+    // bits and returned {777400000000,300000000000} for 0.5 * -0.5.
+    { 0200000000000, 0, 0600000000000, 0700000000000, 0 },
+    { 0600000000000, 0, 0600000000000, 0100000000000, 0 },
+    // 0.75 * -0.25 = -0.1875
+    { 0300000000000, 0, 0700000000000, 0720000000000, 0 },
+    // A product that fits in a single 36-bit limb.  The GMP version used to
+    // read a second limb past the end of the exported result.
+    { 0, 1, 1, 2, 0 },
+    // Zero either way
+    { 0, 0, 0600000000000, 0, 0 },
+    { 0600000000000, 0, 0, 0, 0 },
+};
+
+static void check_mpy72fract_known(const char *name,
+    void (*fn)(t_uint64, t_uint64, t_uint64, t_uint64*, t_uint64*))
+{
+    int n = sizeof(mpy72fract_cases) / sizeof(mpy72fract_cases[0]);
+    for (int i = 0; i < n; ++i) {
+        t_uint64 hi, low;
+        (*fn)(mpy72fract_cases[i].ahi, mpy72fract_cases[i].alow, mpy72fract_cases[i].b, &hi, &low);
+        if (hi != mpy72fract_cases[i].hi || low != mpy72fract_cases[i].low) {
+            ++ nfail;
+            printf("FAIL %s {%012llo,%012llo} * %012llo: got {%012llo,%012llo}, want {%012llo,%012llo}\n",
+                name, mpy72fract_cases[i].ahi, mpy72fract_cases[i].alow, mpy72fract_cases[i].b,
+                hi, low, mpy72fract_cases[i].hi, mpy72fract_cases[i].low);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+ * check_mpy(), check_mpy72fract(), check_div72()
+ *
+ * Run one set of operands through both versions and complain if the
+ * results differ.
+ */
+
+static void check_mpy(t_uint64 a, t_uint64 b)
+{
+    // Callers pass sign extended values; see opu.c
+    a = sign36(a);
+    b = sign36(b);
+    t_uint64 hi, low, ghi, glow;
+    mpy(a, b, &hi, &low);
+    gmp_mpy(a, b, &ghi, &glow);
+    ++ nchecked;
+    if (hi != ghi || low != glow) {
+        if (nfail++ < 20)
+            printf("FAIL mpy %012llo * %012llo: native {%012llo,%012llo}, GMP {%012llo,%012llo}\n",
+                a & MASK36, b & MASK36, hi, low, ghi, glow);
+    }
+}
+
+static void check_mpy72fract(t_uint64 ahi, t_uint64 alow, t_uint64 b)
+{
+    t_uint64 hi, low, ghi, glow;
+    mpy72fract(ahi, alow, b, &hi, &low);
+    gmp_mpy72fract(ahi, alow, b, &ghi, &glow);
+    ++ nchecked;
+    if (hi != ghi || low != glow) {
+        if (nfail++ < 20)
+            printf("FAIL mpy72fract {%012llo,%012llo} * %012llo: native {%012llo,%012llo}, GMP {%012llo,%012llo}\n",
+                ahi, alow, b, hi, low, ghi, glow);
+    }
+}
+
+static void check_div72(t_uint64 hi, t_uint64 low, t_uint64 divisor)
+{
+    if (divisor == 0)
+        return;     // callers check for this
+    t_uint64 quot, rem, gquot, grem;
+    div72(hi, low, divisor, &quot, &rem);
+    gmp_div72(hi, low, divisor, &gquot, &grem);
+    ++ nchecked;
+    if (quot != gquot || rem != grem) {
+        if (nfail++ < 20)
+            printf("FAIL div72 {%012llo,%012llo} / %012llo: native %012llo rem %012llo, GMP %012llo rem %012llo\n",
+                hi, low, divisor, quot, rem, gquot, grem);
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Operands that tend to find trouble: zero, the largest and most negative
+ * values, and each power of two with its neighbours.
+ */
+
+static t_uint64 edges[128];
+static int n_edges;
+
+static void init_edges(void)
+{
+    for (int i = 0; i < 36; ++i) {
+        t_uint64 p = (t_uint64) 1 << i;
+        edges[n_edges++] = p;
+        edges[n_edges++] = (p - 1) & MASK36;
+        edges[n_edges++] = (p + 1) & MASK36;
+    }
+    edges[n_edges++] = MASK36;
+    edges[n_edges++] = MASK36 - 1;
+    edges[n_edges++] = 0600000000000;
+    edges[n_edges++] = 0700000000000;
+}
+
+// 36 random bits, shifted down by a random amount half the time so that
+// small magnitudes show up often
+static t_uint64 random36(void)
+{
+    static t_uint64 x = 88172645463325252ULL;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    t_uint64 v = x & MASK36;
+    if (x >> 63)
+        v >>= (x >> 40) % 36;
+    return v;
+}
+
+int main(int argc, char *argv[])
+{
+    long ncases = (argc > 1) ? atol(argv[1]) : 10000000;
+    unsigned seed = (argc > 2) ? atoi(argv[2]) : 1;
+
+    check_mpy72fract_known("mpy72fract", mpy72fract);
+    check_mpy72fract_known("gmp_mpy72fract", gmp_mpy72fract);
+    printf("Known answers: %d failures.\n", nfail);
+
+    // Exhaustive: every combination of edge values, and every pair of
+    // small operands of either sign
+    init_edges();
+    for (int i = 0; i < n_edges; ++i)
+        for (int j = 0; j < n_edges; ++j) {
+            check_mpy(edges[i], edges[j]);
+            for (int k = 0; k < n_edges; ++k) {
+                check_mpy72fract(edges[i], edges[j], edges[k]);
+                check_div72(edges[i], edges[j], edges[k]);
+            }
+        }
+    for (int i = -512; i < 512; ++i)
+        for (int j = -512; j < 512; ++j) {
+            check_mpy(i & MASK36, j & MASK36);
+            check_mpy72fract(0, i & MASK36, j & MASK36);
+            check_mpy72fract(i & MASK36, 0, j & MASK36);
+            check_div72(0, i & MASK36, j & MASK36);
+        }
+    printf("Exhaustive: %ld checked, %d failures.\n", nchecked, nfail);
+
+    // Random operands
+    for (unsigned i = 0; i < seed; ++i)
+        (void) random36();
+    for (long k = 0; k < ncases; ++k) {
+        t_uint64 a = random36(), b = random36(), c = random36();
+        check_mpy(a, b);
+        check_mpy72fract(a, b, c);
+        check_div72(a, b, c);
+    }
+    printf("Total: %ld checked, %d failures.\n", nchecked, nfail);
+    return nfail != 0;
+}
@@ -23,12 +23,44 @@
 #define FEAT_INSTR_STATS 1
 #define FEAT_INSTR_STATS_TIMING 0
 
-// Memory is represented via 64 bit integers representing the 36bit words. If
-// this #define is true, memory is initialized to all ones and every memory read
-// checked.  If an uninitialized read is found, a warning is displayed, but a zero
-// value is still returned to the emulator as if all memory had been initialized
-// to zero.  Note that normal operation can only write values with the lower 36
-// bits set on but not the remaining 26 of 64 bits.
+// Memory is represented via 64 bit integers representing the 36bit words.
+// Memory starts out as demand-zero pages.  If this #define is true, a shadow
+// bitmap with one bit per word records which words have been written, and
+// reads are checked against it when sys_opts.warn_uninit is set.  If an
+// uninitialized read is found, a warning is displayed; the value returned is
+// zero.
 #define FEAT_MEM_CHECK_UNINIT 1
 
+// Ask the host to back memory with transparent huge pages (Linux madvise).
+// Reduces TLB misses for large working sets at the cost of a larger RSS.
+#define FEAT_MEM_HUGEPAGES 0
+
+// Cache runs of straight-line instructions as pre-decoded blocks and execute
+// them without going through the FETCH and EXEC cycles for every instruction.
+// Only used by the production loop of sim_instr(), i.e. when no debugging,
+// source display, or breakpoints are active.
+#define FEAT_BLOCK_CACHE 1
+
+// Put a small direct-mapped translation cache in front of the SDWAM and
+// PTWAM.  A hit yields the absolute address and page limits without the
+// associative searches or the bound re-check.
+#define FEAT_APU_TLB 1
+
+// Run the repetitions of RPT and RPD instructions in a tight loop instead
+// of through the FETCH and EXEC cycles.  Like the block cache, only used by
+// the production loop of sim_instr().
+#define FEAT_REPEAT_LOOP 1
+
+// Use the GNU MP library for the 72-bit multiply and divide routines in
+// math.c instead of native 128-bit integers.  Much slower; kept as a
+// reference implementation.  "make check-math" builds both versions.
+#ifndef FEAT_MATH_GMP
+#define FEAT_MATH_GMP 0
+#endif
+
+// Do EIS decimal arithmetic on short operands (up to 37 or 38 significant
+// digits) with native 128-bit integers, using decNumber only for longer
+// operands.
+#define FEAT_DEC_NATIVE 1
+
 #endif  // _OPTIONS_H
@@ -71,6 +71,29 @@ static void equalize_mantissas72(const char* op, t_uint64* a_mant_hip, t_uint64*
 
 static uint saved_tro;
 
+// Per-opcode dispatch information, indexed by the full 10-bit opcode.
+// See opu_init_dispatch().
+typedef enum {
+    opu_prep_illegal = 0,   // no such opcode
+    opu_prep_addr_mod,      // normal address modification via addr_mod()
+    opu_prep_eis_ar,        // EIS addr register instr; addr_mod_eis_addr_reg()
+    opu_prep_none           // EIS multiword; handler decodes its own descriptors
+} opu_prep_t;
+
+typedef enum {
+    opu_opnd_none = 0,      // case body does its own fetches, if any
+    opu_opnd_word           // single word fetched via fetch_op() into opu_word
+} opu_opnd_t;
+
+typedef struct {
+    uint8 prep;                         // opu_prep_t
+    uint8 opnd;                         // opu_opnd_t
+    int (*handler)(const instr_t *ip);  // NULL means use switch in do_an_op()
+} opu_dispatch_t;
+
+static opu_dispatch_t opu_dispatch[1024];
+static t_uint64 opu_word;   // operand pre-fetched for opu_opnd_word opcodes
+
 // BUG: move externs to hdr file
 extern switches_t switches;
 
@@ -169,14 +192,14 @@ static int do_an_op()
     cpu.opcode = ip->opcode;
 
     uint op = ip->opcode;
-    char *opname = opcodes2text[op];
 
     cu.rpts = 0;    // current instruction isn't a repeat type instruction (as far as we know so far)
     saved_tro = IR.tally_runout;
 
     int bit27 = op % 2;
     op >>= 1;
-    if (opname == NULL) {
+    const opu_dispatch_t *dp = &opu_dispatch[ip->opcode];
+    if (dp->prep == opu_prep_illegal) {
         if (op == 0172 && bit27 == 1) {
             log_msg(WARN_MSG, "OPU", "Unavailable instruction 0172(1).  The ldo  instruction is only available on ADP aka ORION aka DPS88.  Ignoring instruction.\n");
             cancel_run(STOP_BUG);
@@ -189,45 +212,29 @@ static int do_an_op()
         if (opt_debug) log_msg(DEBUG_MSG, "OPU", "Opcode %#o(%d) -- %s\n", op, bit27, instr2text(ip));
     }
     
-    // Check instr type for format before addr_mod
-    // Todo: check efficiency of lookup table versus switch table
-    // Also consider placing calls to addr_mod() in next switch table
+    // Prepare the operand address as directed by the dispatch table
     flag_t initial_tally = IR.tally_runout;
     cpu.poa = 1;        // prepare operand address flag
-    if (ip->is_eis_multiword) {
-        log_msg(DEBUG_MSG, "OPU", "Skipping addr_mod() for EIS instr.\n");
-    } else if (bit27 == 0) {
-        switch (op) {
-            case opcode0_epp0 + 0:  // BUG: this construct just used to allow counting how many opcodes are implemented
-            case opcode0_epp2 + 0:
-            case opcode0_epp4 + 0:
-            case opcode0_epp6 + 0:
-                addr_mod();
-                break;
-            default:
-                addr_mod();
-        }
-    } else {
-        switch (op) {
-            case opcode1_a4bd + 0:  // BUG: this construct just used to allow counting how many opcodes are implemented
-            case opcode1_a6bd + 0:
-            case opcode1_a9bd + 0:
-            case opcode1_abd + 0:
-            case opcode1_awd + 0:
-            case opcode1_s9bd + 0:
-                addr_mod_eis_addr_reg(ip);
-                break;
-            case opcode1_epp1 + 0:
-            case opcode1_epp3 + 0:
-            case opcode1_epp5 + 0:
-            case opcode1_epp7 + 0:
-                addr_mod();
-                break;
-            default:
-                addr_mod();
-        }
+    switch (dp->prep) {
+        case opu_prep_addr_mod:
+            addr_mod();
+            break;
+        case opu_prep_eis_ar:
+            addr_mod_eis_addr_reg(ip);
+            break;
+        default:
+            log_msg(DEBUG_MSG, "OPU", "Skipping addr_mod() for EIS instr.\n");
     }
     cpu.poa = 0;
+
+    if (dp->opnd == opu_opnd_word) {
+        int ret = fetch_op(ip, &opu_word);
+        if (ret != 0)
+            return ret;
+    }
+
+    if (dp->handler != NULL)
+        return (*dp->handler)(ip);
     
     if (bit27 == 0) {
         switch (op) {
@@ -256,31 +263,21 @@ static int do_an_op()
                 return 0;
             }
 
-            case opcode0_lca: {
-                t_uint64 word;
-                int ret = fetch_op(ip, &word);
-                if (ret == 0) {
-                    reg_A = negate36(word);
-                    IR.zero = reg_A == 0;
-                    IR.neg = bit36_is_neg(reg_A);
-                    IR.overflow = reg_A == ((t_uint64)1<<35);
-                }
-                return ret;
-            }
+            case opcode0_lca:   // operand pre-fetched
+                reg_A = negate36(opu_word);
+                IR.zero = reg_A == 0;
+                IR.neg = bit36_is_neg(reg_A);
+                IR.overflow = reg_A == ((t_uint64)1<<35);
+                return 0;
 
             // opcode0_lcaq unimplemented
 
-            case opcode0_lcq: {
-                t_uint64 word;
-                int ret = fetch_op(ip, &word);
-                if (ret == 0) {
-                    reg_Q = negate36(word);
-                    IR.zero = reg_Q == 0;
-                    IR.neg = bit36_is_neg(reg_Q);
-                    IR.overflow = reg_Q == ((t_uint64)1<<35);
-                }
-                return ret;
-            }
+            case opcode0_lcq:   // operand pre-fetched
+                reg_Q = negate36(opu_word);
+                IR.zero = reg_Q == 0;
+                IR.neg = bit36_is_neg(reg_Q);
+                IR.overflow = reg_Q == ((t_uint64)1<<35);
+                return 0;
 
             case opcode0_lcx0:
             case opcode0_lcx1:
@@ -291,27 +288,21 @@ static int do_an_op()
             case opcode0_lcx6:
             case opcode0_lcx7: {    // Load Complement (into) Index Register N
                 int n = op & 07;
-                t_uint64 word;
-                int ret = fetch_op(ip, &word);
-                if (ret == 0) {
-                    //reg_X[n] = (word >> 18) & MASK18; // reg is 18 bits
-                    //reg_X[n] = (((~ reg_X[n]) & MASK18) + 1) & MASK18;
-                    reg_X[n] = negate18(word >> 18);
-                    log_msg(INFO_MSG, "OPU::instr::lcx*", "X[%d]: Loaded complement of %#llo => %#llo(%d); result is %#o(%d).\n", n, word, word >> 18, sign18(word >>18), reg_X[n], sign18(reg_X[n]));
-                    IR.zero = reg_X[n] == 0;
-                    IR.neg = bit18_is_neg(reg_X[n]);
-                }
-                return ret;
+                t_uint64 word = opu_word;   // operand pre-fetched
+                //reg_X[n] = (word >> 18) & MASK18; // reg is 18 bits
+                //reg_X[n] = (((~ reg_X[n]) & MASK18) + 1) & MASK18;
+                reg_X[n] = negate18(word >> 18);
+                log_msg(INFO_MSG, "OPU::instr::lcx*", "X[%d]: Loaded complement of %#llo => %#llo(%d); result is %#o(%d).\n", n, word, word >> 18, sign18(word >>18), reg_X[n], sign18(reg_X[n]));
+                IR.zero = reg_X[n] == 0;
+                IR.neg = bit18_is_neg(reg_X[n]);
+                return 0;
             }
 
-            case opcode0_lda: {
-                int ret = fetch_op(ip, &reg_A);
-                if (ret == 0) {
-                    IR.zero = reg_A == 0;
-                    IR.neg = bit36_is_neg(reg_A);
-                }
-                return ret;
-            }
+            case opcode0_lda:   // operand pre-fetched
+                reg_A = opu_word;
+                IR.zero = reg_A == 0;
+                IR.neg = bit36_is_neg(reg_A);
+                return 0;
             case opcode0_ldac: {
                 int ret = fetch_op(ip, &reg_A);
                 if (ret == 0) {
@@ -334,22 +325,15 @@ static int do_an_op()
                 }
                 return ret;
             }
-            case opcode0_ldi: {
-                t_uint64 word;
-                int ret = fetch_op(ip, &word);
-                if (ret == 0)
-                    do_ldi_ret(word, 0);
-                return ret;
-            }
+            case opcode0_ldi:   // operand pre-fetched
+                do_ldi_ret(opu_word, 0);
+                return 0;
 
-            case opcode0_ldq: { // load Q reg
-                int ret = fetch_op(ip, &reg_Q);
-                if (ret == 0) {
-                    IR.zero = reg_Q == 0;
-                    IR.neg = bit36_is_neg(reg_Q);
-                }
-                return ret;
-            }
+            case opcode0_ldq:   // load Q reg; operand pre-fetched
+                reg_Q = opu_word;
+                IR.zero = reg_Q == 0;
+                IR.neg = bit36_is_neg(reg_Q);
+                return 0;
             case opcode0_ldqc: {    // load Q reg & clear
                 int ret = fetch_op(ip, &reg_Q);
                 if (ret == 0) {
@@ -369,15 +353,12 @@ static int do_an_op()
             case opcode0_ldx7: {
                 // BUG: manual says bits 0..17, but alm program trying to use constant 2.  Resolved?
                 int n = op & 07;
-                t_uint64 word;
-                int ret = fetch_op(ip, &word);
-                if (ret == 0) {
-                    reg_X[n] = (word >> 18) & MASK18;   // reg is 18 bits
-                    log_msg(DEBUG_MSG, "OPU::instr::ldx*", "X[%d]: Loaded %#llo => %#llo (%#o aka %#o)\n", n, word, word >> 18, reg_X[n], reg_X[n] & MASK18);
-                    IR.zero = reg_X[n] == 0;
-                    IR.neg = bit18_is_neg(reg_X[n]);
-                }
-                return ret;
+                t_uint64 word = opu_word;   // operand pre-fetched
+                reg_X[n] = (word >> 18) & MASK18;   // reg is 18 bits
+                log_msg(DEBUG_MSG, "OPU::instr::ldx*", "X[%d]: Loaded %#llo => %#llo (%#o aka %#o)\n", n, word, word >> 18, reg_X[n], reg_X[n] & MASK18);
+                IR.zero = reg_X[n] == 0;
+                IR.neg = bit18_is_neg(reg_X[n]);
+                return 0;
             }
             case opcode0_lreg: {
                 t_uint64 words[8];
@@ -2665,7 +2646,6 @@ static int do_an_op()
             // rpl unimplemented -- repeat link
             
             case opcode0_rpt: {
-                extern DEVICE cpu_dev; ++ opt_debug; ++ cpu_dev.dctrl;
                 cu.rpts = 1;
                 uint tally = (ip->addr >> 10);
                 uint c = (ip->addr >> 7) & 1;
@@ -2678,12 +2658,11 @@ static int do_an_op()
                 // Setting cu.rpt will cause the instruction to be executed
                 // until the termination is met.
                 // See cpu.c for the rest of the handling.
-                log_msg(INFO_MSG, "OPU", "RPT instruction found\n");
+                if (opt_debug) log_msg(DEBUG_MSG, "OPU", "RPT instruction found\n");
                 return 0;
             }
 
             case opcode0_rpd: {
-                extern DEVICE cpu_dev; ++ opt_debug; if (! cpu_dev.dctrl) ++ cpu_dev.dctrl;
                 if (PPR.IC % 2 == 0) {
                     fault_gen(illproc_fault);
                     return 1;
@@ -2700,8 +2679,7 @@ static int do_an_op()
                 // Setting cu.rpts and cu.rd will cause the instruction to be executed
                 // until the termination is met.
                 // See cpu.c for the rest of the handling.
-                log_msg(NOTIFY_MSG, "OPU", "RPD instruction found\n");
-                cancel_run(STOP_IBKPT);
+                if (opt_debug) log_msg(DEBUG_MSG, "OPU", "RPD instruction found\n");
                 return 0;
             }
 
@@ -2813,6 +2791,10 @@ static int do_an_op()
                 cpup->DSBR.bound = getbits36(word2, 37-36, 14);
                 cpup->DSBR.u = getbits36(word2, 55-36, 1);
                 cpup->DSBR.stack = getbits36(word2, 60-36, 12);
+#if FEAT_BLOCK_CACHE
+                cpu_block_flush();
+#endif
+                apu_tlb_flush();
                 log_msg(INFO_MSG, "OPU::ldbr", "DSBR: addr=%#o, bound=%#o(%u), u=%d, stack=%#o\n",
                     cpup->DSBR.addr, cpup->DSBR.bound, cpup->DSBR.bound, cpup->DSBR.u, cpup->DSBR.stack);
                 return 0;
@@ -2951,6 +2933,10 @@ static int do_an_op()
                     cancel_run(STOP_WARN);
                     return 1;
                 }
+#if FEAT_BLOCK_CACHE
+                cpu_block_flush();
+#endif
+                apu_tlb_flush();
                 int i;
                 for (i = 0; i < 16; ++i) {
                     cpup->SDWAM[i].assoc.is_full = 0;
@@ -3421,6 +3407,10 @@ static int do_an_op()
                     log_msg(WARN_MSG, "OPU::camp", "Unknown enable/disable mode %06o=>%#o\n", TPR.CA, enable);
                     cancel_run(STOP_WARN);
                 }
+#if FEAT_BLOCK_CACHE
+                cpu_block_flush();
+#endif
+                apu_tlb_flush();
                 int i;
                 for (i = 0; i < 16; ++i) {
                     cpup->PTWAM[i].assoc.is_full = 0;
@@ -3484,87 +3474,17 @@ static int do_an_op()
             // sbd unimplemented
             // swd unimplemented
 
-            case opcode1_cmpc: {
-                // extern DEVICE cpu_dev; ++opt_debug; ++ cpu_dev.dctrl;
-                int ret = op_cmpc(ip);
-                // --opt_debug; --cpu_dev.dctrl;
-                return ret;
-            }
+            // EIS multiword instructions (cmpc, scm, scmr, tct, tctr, mlr, mrl,
+            // mvt, mvn, mvne, csl, csr, sztl, sztr, cmpb, btd, dtb, dv3d) are
+            // dispatched through opu_dispatch[] and never reach this switch.
 
             // opcode1_scd unimplemented -- scan characters double
             // opcode1_scdr unimplemented -- scan characters double in reverse
-            case opcode1_scm: { // scan with mask
-                extern DEVICE cpu_dev; ++opt_debug; ++ cpu_dev.dctrl;
-                int ret = op_scm(ip, 1);
-                --opt_debug; --cpu_dev.dctrl;
-                return ret;
-            }
-            
-            case opcode1_scmr: {    // scan with mask in reverse
-                extern DEVICE cpu_dev; ++opt_debug; ++ cpu_dev.dctrl;
-                int ret = op_scm(ip, 0);
-                --opt_debug; --cpu_dev.dctrl;
-                return ret;
-            }
-
-            case opcode1_tct: {
-                extern DEVICE cpu_dev; ++opt_debug; ++ cpu_dev.dctrl;
-                int ret = op_tct(ip, 1);
-                --opt_debug; --cpu_dev.dctrl;
-                return ret;
-            }
-            case opcode1_tctr: {
-                extern DEVICE cpu_dev; ++opt_debug; ++ cpu_dev.dctrl;
-                int ret = op_tct(ip, 0);
-                --opt_debug; --cpu_dev.dctrl;
-                return ret;
-            }
-            case opcode1_mlr: {
-                int ret = op_move_alphanum(ip, 1);
-                return ret;
-            }
-            case opcode1_mrl: {
-                int ret = op_move_alphanum(ip, 0);
-                return ret;
-            }
-
             // mve unimplemented -- move alphanumeric edited
-            case opcode1_mvt: {
-                int ret = op_mvt(ip);
-                return ret;
-            }
             // cmp0 .. cmp7 unimplemented -- compare numeric
 
-            case opcode1_mvn:       // EIS: move numeric
-                return op_mvn(ip);
-
-            case opcode1_mvne:      // EIS: move numeric edited
-                return op_mvne(ip);
-
-            case opcode1_csl: {     // EIS: combine bit strings left
-                extern DEVICE cpu_dev; ++ opt_debug; ++ cpu_dev.dctrl;
-                int ret = op_csl(ip);
-                -- opt_debug; -- cpu_dev.dctrl;
-                return ret;
-            }
-            
-            // csr unimplemented -- combine bit strings right
-
-            case opcode1_cmpb:
-                return op_cmpb(ip);
-
-            // sztl unimplemented -- similar to csl?
-            // sztr unimplemented -- similar to csr?
-
-            case opcode1_btd:       // binary to decimal convert
-                return op_btd(ip);
-
-            case opcode1_dtb:   // decimal to binary convert
-                return op_dtb(ip);
-
             // ad2d unimplemented -- add using two decimal operands
             // ad3d unimplemented -- add using three decimal operands
-
             // sb2d unimplemented -- subtract using two decimal operands; BUG: see comments by rmabee@comcast.net:
         /*
         On Aug 11, 3:14 am, rfm <rma...@comcast.net> wrote:
@@ -3583,9 +3503,6 @@ static int do_an_op()
             // mp2d unimplemented -- multiply using three decimal operands
             // dv2d unimplemented -- divide using two decimal operands; BUG: see comments by rmabee@comcast.net
 
-            case opcode1_dv3d:      // divide using three decimal operands
-                return op_dv3d(ip);
-
             default:
                 log_msg(ERR_MSG, "OPU", "Unimplemented opcode %03o(1)\n", op);
                 cancel_run(STOP_BUG);
@@ -3597,6 +3514,98 @@ static int do_an_op()
 
 // ============================================================================
 
+// Adapters giving the directional EIS handlers the common handler signature
+
+static int op_scm_fwd(const instr_t *ip) { return op_scm(ip, 1); }
+static int op_scm_rev(const instr_t *ip) { return op_scm(ip, 0); }
+static int op_tct_fwd(const instr_t *ip) { return op_tct(ip, 1); }
+static int op_tct_rev(const instr_t *ip) { return op_tct(ip, 0); }
+static int op_csl_fwd(const instr_t *ip) { return op_csl(ip, 1); }
+static int op_csl_rev(const instr_t *ip) { return op_csl(ip, 0); }
+static int op_sztl_fwd(const instr_t *ip) { return op_sztl(ip, 1); }
+static int op_sztl_rev(const instr_t *ip) { return op_sztl(ip, 0); }
+static int op_mlr(const instr_t *ip) { return op_move_alphanum(ip, 1); }
+static int op_mrl(const instr_t *ip) { return op_move_alphanum(ip, 0); }
+
+static void set_dispatch(uint op, int bit27, opu_prep_t prep, opu_opnd_t opnd, int (*handler)(const instr_t *ip))
+{
+    opu_dispatch_t *dp = &opu_dispatch[(op << 1) | bit27];
+    dp->prep = prep;
+    dp->opnd = opnd;
+    dp->handler = handler;
+}
+
+/*
+ * opu_init_dispatch()
+ *
+ * Build the per-opcode dispatch table used by do_an_op().  Every opcode
+ * listed in opcodes0.txt/opcodes1.txt gets normal address modification
+ * unless overridden below.  Opcodes without a handler are executed by the
+ * switch in do_an_op().
+ *
+ * EIS multiword instructions are marked opu_prep_none; opu_is_eis_multiword()
+ * reports these to the instruction decoder.
+ */
+
+void opu_init_dispatch()
+{
+    memset(opu_dispatch, 0, sizeof(opu_dispatch));
+    for (uint i = 0; i < 1024; ++i)
+        if (opcodes2text[i] != NULL)
+            opu_dispatch[i].prep = opu_prep_addr_mod;
+
+    // EIS address register instructions
+    set_dispatch(opcode1_a4bd, 1, opu_prep_eis_ar, opu_opnd_none, NULL);
+    set_dispatch(opcode1_a6bd, 1, opu_prep_eis_ar, opu_opnd_none, NULL);
+    set_dispatch(opcode1_a9bd, 1, opu_prep_eis_ar, opu_opnd_none, NULL);
+    set_dispatch(opcode1_abd, 1, opu_prep_eis_ar, opu_opnd_none, NULL);
+    set_dispatch(opcode1_awd, 1, opu_prep_eis_ar, opu_opnd_none, NULL);
+    set_dispatch(opcode1_s9bd, 1, opu_prep_eis_ar, opu_opnd_none, NULL);
+
+    // Simple loads; the single operand word is fetched before dispatch
+    set_dispatch(opcode0_lda, 0, opu_prep_addr_mod, opu_opnd_word, NULL);
+    set_dispatch(opcode0_ldq, 0, opu_prep_addr_mod, opu_opnd_word, NULL);
+    set_dispatch(opcode0_lca, 0, opu_prep_addr_mod, opu_opnd_word, NULL);
+    set_dispatch(opcode0_lcq, 0, opu_prep_addr_mod, opu_opnd_word, NULL);
+    set_dispatch(opcode0_ldi, 0, opu_prep_addr_mod, opu_opnd_word, NULL);
+    for (int n = 0; n < 8; ++n) {
+        set_dispatch(opcode0_ldx0 + n, 0, opu_prep_addr_mod, opu_opnd_word, NULL);
+        set_dispatch(opcode0_lcx0 + n, 0, opu_prep_addr_mod, opu_opnd_word, NULL);
+    }
+
+    // EIS multiword instructions.  Unimplemented ones have no handler and
+    // end up at the "unimplemented" default of the switch.
+    set_dispatch(opcode1_cmpc, 1, opu_prep_none, opu_opnd_none, op_cmpc);
+    set_dispatch(opcode1_scd, 1, opu_prep_none, opu_opnd_none, NULL);
+    set_dispatch(opcode1_scdr, 1, opu_prep_none, opu_opnd_none, NULL);
+    set_dispatch(opcode1_scm, 1, opu_prep_none, opu_opnd_none, op_scm_fwd);
+    set_dispatch(opcode1_scmr, 1, opu_prep_none, opu_opnd_none, op_scm_rev);
+    set_dispatch(opcode1_tct, 1, opu_prep_none, opu_opnd_none, op_tct_fwd);
+    set_dispatch(opcode1_tctr, 1, opu_prep_none, opu_opnd_none, op_tct_rev);
+    set_dispatch(opcode1_mlr, 1, opu_prep_none, opu_opnd_none, op_mlr);
+    set_dispatch(opcode1_mrl, 1, opu_prep_none, opu_opnd_none, op_mrl);
+    set_dispatch(opcode1_mve, 1, opu_prep_none, opu_opnd_none, NULL);
+    set_dispatch(opcode1_mvt, 1, opu_prep_none, opu_opnd_none, op_mvt);
+    set_dispatch(opcode1_cmpn, 1, opu_prep_none, opu_opnd_none, NULL);
+    set_dispatch(opcode1_mvn, 1, opu_prep_none, opu_opnd_none, op_mvn);
+    set_dispatch(opcode1_mvne, 1, opu_prep_none, opu_opnd_none, op_mvne);
+    set_dispatch(opcode1_csl, 1, opu_prep_none, opu_opnd_none, op_csl_fwd);
+    set_dispatch(opcode1_csr, 1, opu_prep_none, opu_opnd_none, op_csl_rev);
+    set_dispatch(opcode1_cmpb, 1, opu_prep_none, opu_opnd_none, op_cmpb);
+    set_dispatch(opcode1_sztl, 1, opu_prep_none, opu_opnd_none, op_sztl_fwd);
+    set_dispatch(opcode1_sztr, 1, opu_prep_none, opu_opnd_none, op_sztl_rev);
+    set_dispatch(opcode1_btd, 1, opu_prep_none, opu_opnd_none, op_btd);
+    set_dispatch(opcode1_dtb, 1, opu_prep_none, opu_opnd_none, op_dtb);
+    set_dispatch(opcode1_dv3d, 1, opu_prep_none, opu_opnd_none, op_dv3d);
+}
+
+int opu_is_eis_multiword(uint opcode)
+{
+    return opu_dispatch[opcode & MASKBITS(10)].prep == opu_prep_none;
+}
+
+// ============================================================================
+
 void cu_safe_store()
 {
     // Save current Control Unit Data in hidden temporary so a later SCU
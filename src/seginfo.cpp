@@ -132,6 +132,18 @@ void seginfo_dump(void)
 
 // ============================================================================
 
+int seginfo_have_source(void)
+{
+    // Are any source listings loaded?  The CPU uses this to decide whether
+    // or not it needs to track source locations while running.
+    for (int segno = segments_t::min_segno; segno <= segments_t::max_segno; ++ segno)
+        if (! segments(segno).source_list.empty())
+            return 1;
+    return 0;
+}
+
+// ============================================================================
+
 #if 0
 
 extern "C" int seginfo_add_name(int segno, int offset, const char *name);   // BUG
@@ -51,6 +51,7 @@ int seginfo_find_all(int seg, int offset, where_t *wherep);
 int seginfo_automatic_count(int segno, int offset);
 int seginfo_automatic_list(int segno, int offset, int *count, automatic_t *list);
 void seginfo_find_line(int segno, int offset, const char**line, int *lineno);
+int seginfo_have_source(void);
 
 extern int fetch_acc(int (*fetch)(unsigned addr, t_uint64 *wordp), unsigned addr, char bufp[513]);
 